@@ -0,0 +1,213 @@
+#include "Bitboard.h"
+
+using namespace std;
+
+namespace Bitboards {
+
+#pragma region tables
+
+	Bitboard kingAttacks[64];
+	Bitboard knightAttacks[64];
+	Bitboard pawnAttacks[2][64];
+	Bitboard rays[8][64];
+	Magic bishopMagics[64];
+	Magic rookMagics[64];
+	Bitboard between[64][64];
+	Bitboard line[64][64];
+
+	// attack sets for every relevant occupancy of every square
+	Bitboard bishopTable[0x1480];
+	Bitboard rookTable[0x19000];
+
+	// multipliers for the slider tables, found once by a random search for ones that map every occupancy of each square's mask without a destructive collision
+	// they depend on the square numbering and the masks, so they must be searched for again if either changes
+	const Bitboard bishopMagicNumbers[64] = {
+		0x2008021012002502ULL, 0x04D0100110628400ULL, 0x21102080A1021010ULL, 0x2044041080000400ULL,
+		0x0004050402800000ULL, 0x0002010420109560ULL, 0x08040084500A0000ULL, 0x9401002104224008ULL,
+		0x40044350070B0100ULL, 0x90B00888088C1040ULL, 0x0100100440444012ULL, 0x80001104008A0940ULL,
+		0x1042920210504048ULL, 0x0000010420048200ULL, 0x000000A410221000ULL, 0x804800829C901001ULL,
+		0x0040002008010120ULL, 0x8802008424280205ULL, 0x200800010A040010ULL, 0x2420800802004008ULL,
+		0x0012011402A21220ULL, 0x2002028508022208ULL, 0x0486200049100802ULL, 0x2000211101080200ULL,
+		0x8020200044140C60ULL, 0x0810680C05080381ULL, 0x0001442028012400ULL, 0x4028088008020002ULL,
+		0x25C1001041004010ULL, 0x0401020049080140ULL, 0x0004004084210400ULL, 0x40010900104400A0ULL,
+		0x011011480004A800ULL, 0x0082020200A0680BULL, 0x0800203000080082ULL, 0x0005020081880080ULL,
+		0x1050120080001004ULL, 0x0020008880030810ULL, 0x2241180900008C30ULL, 0x0201451101012400ULL,
+		0x8444016008025000ULL, 0x0002080104000800ULL, 0x2801001490090200ULL, 0x0500142018001100ULL,
+		0x0300040408200400ULL, 0x0008008800820810ULL, 0x0804210204004212ULL, 0x000800A698800202ULL,
+		0x0411040202401000ULL, 0x0A008C051802000EULL, 0x1002A100A8040022ULL, 0x00000C0084042600ULL,
+		0x1000884048220000ULL, 0x0082200410208000ULL, 0x0222020441140022ULL, 0x1004080800408810ULL,
+		0x0022410801500201ULL, 0x010000410818020BULL, 0x2044000044040410ULL, 0x00200C0100208801ULL,
+		0x080800200A102400ULL, 0x000404C010020090ULL, 0x1002101418808C03ULL, 0x0011300081040020ULL
+	};
+	const Bitboard rookMagicNumbers[64] = {
+		0x0080068051E04000ULL, 0x0040001000402000ULL, 0x0080100020008008ULL, 0x4E000A0010208440ULL,
+		0x4200040802002010ULL, 0x0100010008020400ULL, 0x9080608019000600ULL, 0x8100020080204100ULL,
+		0x4103800480400020ULL, 0x8015004004802100ULL, 0x000200108A002040ULL, 0x0801000821001000ULL,
+		0x0015000500080070ULL, 0x0120800400800200ULL, 0x0109000432001100ULL, 0x020080055B000080ULL,
+		0x0080004000402002ULL, 0x5260848020004008ULL, 0x2402020014402080ULL, 0x3000808010000802ULL,
+		0x0304018004810800ULL, 0x0000808004000200ULL, 0x0002040001500248ULL, 0x0012020000408401ULL,
+		0x8440008080004020ULL, 0x0804200840100040ULL, 0x0820008080201000ULL, 0x2080100100082100ULL,
+		0x0001000500100800ULL, 0x00A1000900028400ULL, 0x0100100400C80102ULL, 0x000001120000A044ULL,
+		0x800080C004800620ULL, 0x4040081000202000ULL, 0x0D08802008801000ULL, 0x1000800800801004ULL,
+		0x1004000801010010ULL, 0x0402800400800200ULL, 0x0004080204008110ULL, 0x0000404082000401ULL,
+		0x00C0118861408000ULL, 0x1100220081020048ULL, 0x09A0430420050010ULL, 0x0000082200420010ULL,
+		0x2110080004008080ULL, 0x2004201040680104ULL, 0x1106001451820008ULL, 0x0002224104820014ULL,
+		0x00800C8044210500ULL, 0x02A0200040100040ULL, 0x040100A0001E4100ULL, 0x00204023108A0200ULL,
+		0x2400080080040080ULL, 0x1289008400020900ULL, 0x0002088250010400ULL, 0x0001006084010200ULL,
+		0x0001023480002141ULL, 0x0006400021810015ULL, 0x8400100840200101ULL, 0x40003000A1000825ULL,
+		0x1002011008200402ULL, 0x100D000400080201ULL, 0x0020048806102904ULL, 0x8401000020804201ULL
+	};
+
+	// row and col steps for each direction
+	const signed char directionSteps[8][2] = {
+		{-1, 0},
+		{1, 0},
+		{0, 1},
+		{0, -1},
+		{-1, 1},
+		{-1, -1},
+		{1, 1},
+		{1, -1}
+	};
+
+#pragma endregion
+
+#pragma region functions
+
+	// returns a pseudo random number and advances the state | xorshift64*, so a fixed seed gives the same numbers every run
+	Bitboard random(Bitboard* state) {
+		*state ^= *state >> 12;
+		*state ^= *state << 25;
+		*state ^= *state >> 27;
+		return *state * 2685821657736338717ULL;
+	}
+
+	// fills the lookup data of one slider type
+	// each square's attack sets take 2 ^ (mask size) entries of the table, indexed by pext or by the magic multiplier
+	void initMagics(
+		Magic magics[64],
+		Bitboard* table,
+		const Direction directions[4],
+		const Bitboard magicNumbers[64]
+	) {
+		Bitboard* nextAttacks = table;
+
+		for (unsigned char square = 0; square < 64; square++) {
+			Magic& magic = magics[square];
+
+			// the last square of each ray does not affect the attacks
+			magic.mask = 0;
+			for (unsigned char i = 0; i < 4; i++) {
+				Bitboard ray = rays[directions[i]][square];
+				if (ray) {
+					bool increasing = directions[i] == DOWN || directions[i] == RIGHT || directions[i] == DOWN_RIGHT || directions[i] == DOWN_LEFT;
+					magic.mask |= ray & ~squareBit(increasing ? msb(ray) : lsb(ray));
+				}
+			}
+			magic.shift = 64 - popCount(magic.mask);
+			magic.magic = magicNumbers[square];
+			magic.attacks = nextAttacks;
+			nextAttacks += 1ULL << popCount(magic.mask);
+
+			// enumerates every subset of the mask
+			Bitboard subset = 0;
+			do {
+				Bitboard attacks = 0;
+				for (unsigned char i = 0; i < 4; i++) {
+					attacks |= rayAttacks(directions[i], square, subset);
+				}
+				magic.attacks[magic.index(subset)] = attacks;
+				subset = (subset - magic.mask) & magic.mask;
+			} while (subset);
+		}
+	}
+
+	// returns the square offset by the given steps, or 64 if it is off the board
+	unsigned char offsetSquare(
+		unsigned char square,
+		signed char rowStep,
+		signed char colStep
+	) {
+		signed char row = square / 8 + rowStep;
+		signed char col = square % 8 + colStep;
+		if (row < 0 || row > 7 || col < 0 || col > 7) {
+			return 64;
+		}
+		return (row * 8) + col;
+	}
+
+	// fills the attack tables | called once by Position::initTables
+	void init() {
+		const signed char kingSteps[8][2] = { {-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1} };
+		const signed char knightSteps[8][2] = { {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1} };
+
+		for (unsigned char square = 0; square < 64; square++) {
+			kingAttacks[square] = 0;
+			knightAttacks[square] = 0;
+			for (unsigned char i = 0; i < 8; i++) {
+				unsigned char kingSquare = offsetSquare(square, kingSteps[i][0], kingSteps[i][1]);
+				if (kingSquare < 64) {
+					kingAttacks[square] |= squareBit(kingSquare);
+				}
+				unsigned char knightSquare = offsetSquare(square, knightSteps[i][0], knightSteps[i][1]);
+				if (knightSquare < 64) {
+					knightAttacks[square] |= squareBit(knightSquare);
+				}
+			}
+
+			// white pawns move up the board (towards row 0) and black pawns move down
+			Bitboard bit = squareBit(square);
+			pawnAttacks[WHITE][square] = ((bit >> 7) & ~COL_A) | ((bit >> 9) & ~COL_H);
+			pawnAttacks[BLACK][square] = ((bit << 9) & ~COL_A) | ((bit << 7) & ~COL_H);
+
+			for (unsigned char direction = 0; direction < 8; direction++) {
+				rays[direction][square] = 0;
+				unsigned char raySquare = offsetSquare(square, directionSteps[direction][0], directionSteps[direction][1]);
+				while (raySquare < 64) {
+					rays[direction][square] |= squareBit(raySquare);
+					raySquare = offsetSquare(raySquare, directionSteps[direction][0], directionSteps[direction][1]);
+				}
+			}
+		}
+
+		const Direction bishopDirections[4] = { UP_RIGHT, UP_LEFT, DOWN_RIGHT, DOWN_LEFT };
+		const Direction rookDirections[4] = { UP, DOWN, RIGHT, LEFT };
+		initMagics(bishopMagics, bishopTable, bishopDirections, bishopMagicNumbers);
+		initMagics(rookMagics, rookTable, rookDirections, rookMagicNumbers);
+
+		for (unsigned char start = 0; start < 64; start++) {
+			for (unsigned char end = 0; end < 64; end++) {
+				between[start][end] = 0;
+				line[start][end] = 0;
+				Bitboard endBit = squareBit(end);
+				if (bishopAttacks(start, 0) & endBit) {
+					between[start][end] = bishopAttacks(start, endBit) & bishopAttacks(end, squareBit(start));
+					line[start][end] = (bishopAttacks(start, 0) & bishopAttacks(end, 0)) | squareBit(start) | endBit;
+				}
+				else if (rookAttacks(start, 0) & endBit) {
+					between[start][end] = rookAttacks(start, endBit) & rookAttacks(end, squareBit(start));
+					line[start][end] = (rookAttacks(start, 0) & rookAttacks(end, 0)) | squareBit(start) | endBit;
+				}
+			}
+		}
+	}
+
+	// returns the squares attacked by a slider in one direction, stopping at the first occupied square
+	Bitboard rayAttacks(
+		Direction direction,
+		unsigned char square,
+		Bitboard occupied
+	) {
+		Bitboard attacks = rays[direction][square];
+		Bitboard blockers = attacks & occupied;
+		if (blockers) {
+
+			// rays that increase the square number are blocked by their lowest blocker, the others by their highest
+			bool increasing = direction == DOWN || direction == RIGHT || direction == DOWN_RIGHT || direction == DOWN_LEFT;
+			attacks ^= rays[direction][increasing ? lsb(blockers) : msb(blockers)];
+		}
+		return attacks;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
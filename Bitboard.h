@@ -0,0 +1,214 @@
+#pragma once
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// define BITBOARD_USE_PEXT when building for a cpu with a fast BMI2 pext (intel haswell or later, amd zen 3 or later) to index the slider tables with it
+// it is never picked automatically, since pext is microcoded and far slower than the magic multiply on earlier amd cpus
+#ifdef BITBOARD_USE_PEXT
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// a set of squares packed into 64 bits
+// squares are numbered the same way as Position::rowColToChar: (row * 8) + col, so a8 is 0 and h1 is 63
+typedef unsigned long long Bitboard;
+
+enum Color : unsigned char {
+	WHITE,
+	BLACK
+};
+
+enum PieceType : unsigned char {
+	PAWN,
+	KNIGHT,
+	BISHOP,
+	ROOK,
+	QUEEN,
+	KING,
+	NO_PIECE_TYPE
+};
+
+enum Direction : unsigned char {
+	UP,
+	DOWN,
+	RIGHT,
+	LEFT,
+	UP_RIGHT,
+	UP_LEFT,
+	DOWN_RIGHT,
+	DOWN_LEFT
+};
+
+const Bitboard COL_A = 0x0101010101010101ULL;
+const Bitboard COL_H = COL_A << 7;
+const Bitboard ROW_8 = 0xFFULL;
+const Bitboard ROW_1 = ROW_8 << 56;
+
+#pragma region bit operations
+
+// returns a bitboard with only the given square set
+inline Bitboard squareBit(unsigned char square) {
+	return 1ULL << square;
+}
+
+// returns the number of set squares
+inline unsigned char popCount(Bitboard bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	return (unsigned char)__popcnt64(bitboard);
+#elif defined(__GNUC__)
+	return (unsigned char)__builtin_popcountll(bitboard);
+#else
+	unsigned char count = 0;
+	while (bitboard) {
+		bitboard &= bitboard - 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// returns the lowest set square | bitboard must not be empty
+inline unsigned char lsb(Bitboard bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanForward64(&index, bitboard);
+	return (unsigned char)index;
+#elif defined(__GNUC__)
+	return (unsigned char)__builtin_ctzll(bitboard);
+#else
+	unsigned char index = 0;
+	while (!(bitboard & 1)) {
+		bitboard >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+// returns the highest set square | bitboard must not be empty
+inline unsigned char msb(Bitboard bitboard) {
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long index;
+	_BitScanReverse64(&index, bitboard);
+	return (unsigned char)index;
+#elif defined(__GNUC__)
+	return (unsigned char)(63 ^ __builtin_clzll(bitboard));
+#else
+	unsigned char index = 0;
+	while (bitboard >>= 1) {
+		index++;
+	}
+	return index;
+#endif
+}
+
+// removes the lowest set square from the bitboard and returns it
+inline unsigned char popLsb(Bitboard* bitboard) {
+	unsigned char square = lsb(*bitboard);
+	*bitboard &= *bitboard - 1;
+	return square;
+}
+
+// returns true if more than one square is set
+inline bool moreThanOne(Bitboard bitboard) {
+	return (bitboard & (bitboard - 1)) != 0;
+}
+
+#pragma endregion
+
+namespace Bitboards {
+
+	// lookup data for the attacks of a slider on one square
+	struct Magic {
+		Bitboard mask;			// squares whose occupancy affects the attacks, not including the board edges
+		Bitboard magic;			// multiplier that maps every occupancy of mask to an index with the right attacks | unused with pext
+		Bitboard* attacks;		// attack sets for this square, indexed by index()
+		unsigned char shift;	// 64 minus the number of squares in mask
+
+		// returns the index of the attack set for the given occupancy
+		unsigned int index(Bitboard occupied) const {
+#ifdef BITBOARD_USE_PEXT
+			return (unsigned int)_pext_u64(occupied, mask);
+#else
+			return (unsigned int)(((occupied & mask) * magic) >> shift);
+#endif
+		}
+	};
+
+#pragma region tables
+
+	// squares attacked by a king on each square
+	extern Bitboard kingAttacks[64];
+
+	// squares attacked by a knight on each square
+	extern Bitboard knightAttacks[64];
+
+	// squares attacked by a pawn of each color on each square
+	extern Bitboard pawnAttacks[2][64];
+
+	// squares from each square to the edge of the board in each direction, not including the square itself
+	extern Bitboard rays[8][64];
+
+	// bishop attack lookup for each square
+	extern Magic bishopMagics[64];
+
+	// rook attack lookup for each square
+	extern Magic rookMagics[64];
+
+	// squares strictly between two squares that share a row, col or diagonal | empty otherwise
+	extern Bitboard between[64][64];
+
+	// the whole row, col or diagonal through two squares | empty if they do not share one
+	extern Bitboard line[64][64];
+
+#pragma endregion
+
+#pragma region functions
+
+	// fills the attack tables | called once by Position::initTables
+	void init();
+
+	// returns a pseudo random number and advances the state | xorshift64*, so a fixed seed gives the same numbers every run
+	Bitboard random(Bitboard* state);
+
+	// returns the squares attacked by a slider in one direction, stopping at the first occupied square
+	// only used to build the lookup tables | use bishopAttacks and rookAttacks instead
+	Bitboard rayAttacks(
+		Direction direction,
+		unsigned char square,
+		Bitboard occupied
+	);
+
+	// returns the squares attacked by a bishop
+	inline Bitboard bishopAttacks(
+		unsigned char square,
+		Bitboard occupied
+	) {
+		const Magic& magic = bishopMagics[square];
+		return magic.attacks[magic.index(occupied)];
+	}
+
+	// returns the squares attacked by a rook
+	inline Bitboard rookAttacks(
+		unsigned char square,
+		Bitboard occupied
+	) {
+		const Magic& magic = rookMagics[square];
+		return magic.attacks[magic.index(occupied)];
+	}
+
+	// returns the squares attacked by a set of pawns of the given color
+	inline Bitboard pawnSetAttacks(
+		Color color,
+		Bitboard pawns
+	) {
+		return color == WHITE ?
+			((pawns >> 7) & ~COL_A) | ((pawns >> 9) & ~COL_H) :
+			((pawns << 9) & ~COL_A) | ((pawns << 7) & ~COL_H);
+	}
+
+#pragma endregion
+}
\ No newline at end of file
@@ -1,11 +1,180 @@
 #include "Bryan.h"
 
-Bryan::Bryan() {}
+// constructs an engine with a transposition table of the given size in megabytes that searches on the given number of threads
+Bryan::Bryan(
+	unsigned int hashMegabytes,
+	unsigned int threadCount
+) :
+	table(hashMegabytes),
+	activeThreads(0)
+{
+	setThreads(threadCount);
+}
 
+// stops any running search and waits for its threads
+Bryan::~Bryan() {
+	stopSearch();
+	pool->wait();
+}
+
+// resizes the transposition table | everything it remembered is lost
+void Bryan::setHashSize(unsigned int megabytes) {
+	stopSearch();
+	pool->wait();
+	table.resize(megabytes);
+}
+
+// empties the transposition table, the move ordering statistics and the pawn tables, for example before analyzing an unrelated game
+void Bryan::clearHash() {
+	stopSearch();
+	pool->wait();
+	table.clear();
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		threads[i]->clearHistory();
+	}
+}
+
+// returns a description of the kind of memory pages backing the transposition table, for logging
+string Bryan::hashPageMode() {
+	return table.pageModeName();
+}
+
+// returns the size of the transposition table in megabytes | the requested size rounded down to a power of two
+unsigned int Bryan::hashSize() {
+	return table.megabytes();
+}
+
+// returns the permille of the transposition table written by the current or last search | may be called while it runs
+unsigned int Bryan::hashfull() {
+	return table.hashfull();
+}
+
+// sets the number of threads that search together | at least one is always used
+void Bryan::setThreads(unsigned int threadCount) {
+	if (pool) {
+		stopSearch();
+		pool->wait();
+	}
+	threadCount = max(threadCount, 1u);
+	pool.reset();
+	threads.clear();
+	for (unsigned int i = 0; i < threadCount; i++) {
+		threads.push_back(unique_ptr<SearchThread>(new SearchThread(i, &table, &parameters, &control)));
+	}
+	pool.reset(new ThreadPool(threadCount));
+}
+
+// changes a pruning or reduction setting by name, from the next search on | a running search is stopped first
+// returns false if there is no such setting | SearchParameters::names() lists them
+bool Bryan::setParameter(
+	string name,
+	int value
+) {
+	stopSearch();
+	pool->wait();
+	return parameters.set(name, value);
+}
+
+// returns the current value of a pruning or reduction setting by name | 0 if there is no such setting
+int Bryan::getParameter(string name) {
+	return parameters.get(name);
+}
+
+// searches the position to the given depth and returns the score, best move and principal variation
+// every depth from 1 up is searched in turn, each one seeded with the line and score of the one before
+// with more than one thread the helpers search alongside the main thread until it reaches the depth, and the deepest result of any thread is returned
+// the score is in pawns from white's point of view
 Evaluation Bryan::analyzePosition(
 	Position position,
 	unsigned short int depth
 ) {
-	Evaluation out;
+	SearchLimits limits;
+	limits.depth = max(depth, (unsigned short int)1);
+	startSearch(position, limits);
+	return waitForSearch();
+}
+
+// starts searching the position in the background and returns at once | a search that is already running is stopped first
+// onIteration is called on the main search thread with the result of every depth it completes, so it must not block for long
+void Bryan::startSearch(
+	Position position,
+	SearchLimits limits,
+	function<void(const Evaluation&)> onIteration
+) {
+	stopSearch();
+	pool->wait();
+
+	root = position;
+	control.stop = false;
+	control.nodes = 0;
+	control.nodeLimit = limits.nodes;
+	control.timeLimit = limits.milliseconds;
+	control.startTime = chrono::steady_clock::now();
+	control.onIteration = onIteration;
+	table.newSearch();
+	activeThreads = (unsigned int)threads.size();
+
+	// the helpers are given no depth limit | they are stopped by the main thread
+	for (unsigned int i = 1; i < threads.size(); i++) {
+		SearchThread* helper = threads[i].get();
+		pool->submit([this, helper, position]() {
+			helper->iterate(position, MAX_PLY);
+			activeThreads--;
+		});
+	}
+	SearchThread* main = threads[0].get();
+	int maxDepth = limits.depth ? limits.depth : MAX_PLY;
+	pool->submit([this, main, position, maxDepth]() {
+		main->iterate(position, maxDepth);
+		control.stop = true;
+		activeThreads--;
+	});
+}
+
+// tells the running search to stop as soon as possible | safe to call from any thread
+void Bryan::stopSearch() {
+	control.stop = true;
+}
+
+// changes the node limit of the running search | safe to call from any thread
+void Bryan::setNodeLimit(unsigned long long nodes) {
+	control.nodeLimit = nodes;
+}
+
+// changes the time limit of the running search, counted from its start | safe to call from any thread
+void Bryan::setTimeLimit(unsigned long long milliseconds) {
+	control.timeLimit = milliseconds;
+}
+
+// returns true while any thread of the search is still running
+bool Bryan::searching() {
+	return activeThreads > 0;
+}
+
+// blocks until the search has finished and returns its result
+// a search stopped before its first iteration finished still returns a legal move if there is one
+Evaluation Bryan::waitForSearch() {
+	pool->wait();
+
+	// a helper that got further than the main thread has the better result | ties go to the main thread
+	SearchThread* best = threads[0].get();
+	unsigned long long nodes = 0;
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		nodes += threads[i]->nodes;
+		if (threads[i]->completedDepth > best->completedDepth) {
+			best = threads[i].get();
+		}
+	}
+	Evaluation out = best->evaluation(root.whiteMove);
+	out.nodes = nodes;
+
+	if (out.bestMove == Move::none()) {
+		MoveList moves;
+		root.legalMoves(&moves);
+		if (moves.size()) {
+			out.bestMove = moves[0];
+			out.line.assign(1, moves[0]);
+		}
+	}
 	return out;
 }
\ No newline at end of file
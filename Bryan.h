@@ -1,13 +1,108 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include "Position.h"
 #include "Evaluation.h"
+#include "TranspositionTable.h"
+#include "SearchThread.h"
+#include "ThreadPool.h"
+
+const unsigned int DEFAULT_HASH = 16;			// transposition table size in megabytes
+const unsigned int DEFAULT_THREADS = 1;			// search threads, including the main one
+
+// limits on a search | 0 means no limit, and a search without any limit runs until it is stopped
+struct SearchLimits {
+	unsigned short int depth = 0;			// deepest iteration searched
+	unsigned long long nodes = 0;			// positions visited by every thread together
+	unsigned long long milliseconds = 0;	// time from the start of the search
+};
 
 class Bryan {
-	Bryan();
+public:
+
+	// constructs an engine with a transposition table of the given size in megabytes that searches on the given number of threads
+	Bryan(
+		unsigned int hashMegabytes = DEFAULT_HASH,
+		unsigned int threadCount = DEFAULT_THREADS
+	);
+
+	// stops any running search and waits for its threads
+	~Bryan();
+
+	// resizes the transposition table | everything it remembered is lost
+	void setHashSize(unsigned int megabytes);
+
+	// empties the transposition table, the move ordering statistics and the pawn tables, for example before analyzing an unrelated game
+	void clearHash();
+
+	// returns a description of the kind of memory pages backing the transposition table, for logging
+	string hashPageMode();
+
+	// returns the size of the transposition table in megabytes | the requested size rounded down to a power of two
+	unsigned int hashSize();
+
+	// returns the permille of the transposition table written by the current or last search | may be called while it runs
+	unsigned int hashfull();
+
+	// sets the number of threads that search together | at least one is always used
+	void setThreads(unsigned int threadCount);
+
+	// changes a pruning or reduction setting by name, from the next search on | a running search is stopped first
+	// returns false if there is no such setting | SearchParameters::names() lists them
+	bool setParameter(
+		string name,
+		int value
+	);
 
+	// returns the current value of a pruning or reduction setting by name | 0 if there is no such setting
+	int getParameter(string name);
+
+	// searches the position to the given depth and returns the score, best move and principal variation
+	// every depth from 1 up is searched in turn, each one seeded with the line and score of the one before
+	// with more than one thread the helpers search alongside the main thread until it reaches the depth, and the deepest result of any thread is returned
+	// the score is in pawns from white's point of view
 	Evaluation analyzePosition(
 		Position position,
 		unsigned short int depth
 	);
+
+	// starts searching the position in the background and returns at once | a search that is already running is stopped first
+	// onIteration is called on the main search thread with the result of every depth it completes, so it must not block for long
+	void startSearch(
+		Position position,
+		SearchLimits limits,
+		function<void(const Evaluation&)> onIteration = nullptr
+	);
+
+	// tells the running search to stop as soon as possible | safe to call from any thread
+	void stopSearch();
+
+	// changes the node limit of the running search | safe to call from any thread
+	void setNodeLimit(unsigned long long nodes);
+
+	// changes the time limit of the running search, counted from its start | safe to call from any thread
+	void setTimeLimit(unsigned long long milliseconds);
+
+	// returns true while any thread of the search is still running
+	bool searching();
+
+	// blocks until the search has finished and returns its result
+	// a search stopped before its first iteration finished still returns a legal move if there is one
+	Evaluation waitForSearch();
+
+private:
+
+#pragma region variables
+
+	TranspositionTable table;						// results of earlier searches, kept between calls and shared by every thread
+	SearchParameters parameters;					// pruning and reduction settings shared by every thread
+	SearchControl control;							// stop flag and limits of the current search
+	Position root;									// position of the current search
+	vector<unique_ptr<SearchThread>> threads;		// the main thread followed by the helpers
+	unique_ptr<ThreadPool> pool;					// runs one search thread per worker
+	atomic<unsigned int> activeThreads;				// search threads that have not finished yet
+
+#pragma endregion
 };
\ No newline at end of file
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <vector>
-#include <string>
+#include "Move.h"
 
 using namespace std;
 
+// the result of a search
 struct Evaluation {
-	double eval;
-	string bestMove;
-	vector<string> line;
+	double eval;					// score in pawns from white's point of view | a forced mate is about +-320, see mate for its distance
+	Move bestMove;					// Move::none() if the side to move has no legal move
+	vector<Move> line;				// principal variation, starting with bestMove
+	unsigned short int depth;		// deepest iteration that was finished
+	unsigned long long nodes;		// positions visited by every thread
+	short int mate = 0;				// moves until the forced mate in line, positive if white mates and negative if black does | 0 if no mate was found or checkmated is set
+	bool checkmated = false;		// true if the side to move is already checkmated, a mate in 0 | the sign of eval gives the winner
 };
\ No newline at end of file
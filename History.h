@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstring>
+#include "Move.h"
+
+using namespace std;
+
+const int MAX_HISTORY = 16384;		// history scores stay between -MAX_HISTORY and MAX_HISTORY
+
+// move ordering statistics that a search thread learns from the quiet moves that cause cutoffs
+// pieces are indexed by (color * 6) + type
+struct History {
+	short butterfly[2][64][64];				// how often each color's move from a square to a square was good
+	Move counterMoves[12][64];				// the quiet move that last refuted a move of each piece to each square
+	short continuation[12][64][12][64];		// how good a move of a piece to a square was straight after a given earlier move
+
+	// forgets everything
+	void clear() {
+		memset(butterfly, 0, sizeof(butterfly));
+		memset(counterMoves, 0, sizeof(counterMoves));
+		memset(continuation, 0, sizeof(continuation));
+	}
+
+	// moves a score towards the bonus, by less the closer it already is to the limit, so that old results fade
+	static void update(
+		short* score,
+		int bonus
+	) {
+		*score += (short)(bonus - *score * (bonus < 0 ? -bonus : bonus) / MAX_HISTORY);
+	}
+};
\ No newline at end of file
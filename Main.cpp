@@ -1,24 +1,233 @@
 #include <iostream>
 #include <chrono>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include "Bryan.h"
+#include "Perft.h"
 
-int main() {
-	Position pos = Position::StartingPosition();
+// printed instead of running when the arguments cannot be read
+const string ANALYZE_USAGE = "usage: Bryan analyze <depth> [threads <count>] [hash <megabytes>] [movetime <milliseconds>] [nodes <count>] [set <name> <value>]... [FEN]";
+const string PERFT_USAGE = "usage: Bryan [perft <depth> [divide] [threads <count>] [hash <megabytes>] [FEN]]";
+
+// returns who mates and in how many moves, for example "white in 2" | an empty string if the search found no mate
+string mateText(const Evaluation& evaluation) {
+	if (evaluation.checkmated) {
+		return string(evaluation.eval > 0 ? "white" : "black") + " in 0";
+	}
+	if (evaluation.mate) {
+		return string(evaluation.mate > 0 ? "white" : "black") + " in " + to_string(abs(evaluation.mate));
+	}
+	return "";
+}
+
+// adds an argument that is not an option to the FEN | the fields of a FEN arrive as separate arguments
+void addToFEN(
+	string* FEN,
+	string word
+) {
+	*FEN += (FEN->empty() ? "" : " ") + word;
+}
+
+// sets position to the FEN, or to the starting position if the FEN is empty
+// returns false if the FEN cannot be read or does not give each side exactly one king
+bool readPosition(
+	string FEN,
+	Position* position
+) {
+	if (FEN.empty()) {
+		*position = Position::StartingPosition();
+		return true;
+	}
+	try {
+		*position = Position(FEN);
+	}
+	catch (const exception&) {
+		return false;
+	}
+	return popCount(position->pieceBoards[WHITE][KING]) == 1 && popCount(position->pieceBoards[BLACK][KING]) == 1;
+}
+
+// usage: Bryan analyze <depth> [threads <count>] [hash <megabytes>] [movetime <milliseconds>] [nodes <count>] [set <name> <value>]... [FEN]
+// the options may come in any order, and whatever is not an option is read as the FEN
+// a depth of 0 searches until the time or node limit runs out
+// set changes a pruning or reduction setting and can be given more than once | SearchParameters lists them
+// every completed iteration is printed as the search runs
+void runAnalysis(
+	int argc,
+	char* argv[]
+) {
+	SearchLimits limits;
+	unsigned int threads = DEFAULT_THREADS;
+	unsigned int hash = DEFAULT_HASH;
+	vector<pair<string, int>> settings;
+	string FEN = "";
+	try {
+		limits.depth = stoi(argv[2]);
+		for (int arg = 3; arg < argc; arg++) {
+			string word = argv[arg];
+			if (word == "threads" && arg + 1 < argc) {
+				threads = max(stoi(argv[++arg]), 1);
+			}
+			else if (word == "hash" && arg + 1 < argc) {
+				hash = max(stoi(argv[++arg]), 1);
+			}
+			else if (word == "movetime" && arg + 1 < argc) {
+				limits.milliseconds = stoull(argv[++arg]);
+			}
+			else if (word == "nodes" && arg + 1 < argc) {
+				limits.nodes = stoull(argv[++arg]);
+			}
+			else if (word == "set" && arg + 2 < argc) {
+				settings.push_back(make_pair(string(argv[arg + 1]), stoi(argv[arg + 2])));
+				arg += 2;
+			}
+			else {
+				addToFEN(&FEN, word);
+			}
+		}
+	}
+	catch (const exception&) {
+		cout << ANALYZE_USAGE << endl;
+		return;
+	}
+	if (!limits.depth && !limits.milliseconds && !limits.nodes) {
+		limits.depth = 1;
+	}
+
+	Position pos;
+	if (!readPosition(FEN, &pos)) {
+		cout << ANALYZE_USAGE << endl;
+		return;
+	}
+	pos.printBoard();
 
 	auto start = chrono::high_resolution_clock::now();
 
-	vector<string> moves = pos.legalMoves();
+	Bryan bryan(hash, threads);
+	for (const pair<string, int>& setting : settings) {
+		if (!bryan.setParameter(setting.first, setting.second)) {
+			cout << "Unknown setting: " << setting.first << " | the settings are";
+			for (const string& name : SearchParameters::names()) {
+				cout << " " << name;
+			}
+			cout << endl;
+		}
+		else {
+			cout << "Setting: " << setting.first << " = " << bryan.getParameter(setting.first) << endl;
+		}
+	}
+	bryan.startSearch(pos, limits, [&bryan](const Evaluation& update) {
+		cout << "depth " << update.depth << " eval " << update.eval;
+		if (!mateText(update).empty()) {
+			cout << " mate " << mateText(update);
+		}
+		cout << " nodes " << update.nodes << " hashfull " << bryan.hashfull() << " line";
+		for (unsigned short int i = 0; i < update.line.size(); i++) {
+			cout << " " << Position::uciMove(update.line[i]);
+		}
+		cout << endl;
+	});
+	Evaluation evaluation = bryan.waitForSearch();
 
 	auto finish = chrono::high_resolution_clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
 	auto seconds = duration.count() / 1000000.0;
 
-	pos.printBoard();
-	cout << "Legal Moves: " << moves.size() << endl;
-	for (unsigned char i = 0; i < moves.size(); i++) {
-		cout << Position::translateMove(moves.at(i)) << endl;
+	cout << endl;
+	cout << "Depth: " << evaluation.depth << endl;
+	cout << "Threads: " << threads << endl;
+	cout << "Hash: " << bryan.hashSize() << " MB (" << bryan.hashPageMode() << ")" << endl;
+	cout << "Hash Full: " << bryan.hashfull() << " permille" << endl;
+	cout << "Eval: " << evaluation.eval << endl;
+	if (!mateText(evaluation).empty()) {
+		cout << "Mate: " << mateText(evaluation) << endl;
+	}
+	cout << "Best Move: " << Position::translateMove(evaluation.bestMove) << endl;
+	cout << "Line:";
+	for (unsigned short int i = 0; i < evaluation.line.size(); i++) {
+		cout << " " << Position::uciMove(evaluation.line[i]);
 	}
 	cout << endl;
+	cout << "Nodes: " << evaluation.nodes << endl;
 	cout << "Seconds Elapsed: " << seconds << endl;
-	cout << "Nodes Per Second: " << moves.size() / seconds << endl;
+	cout << "Nodes Per Second: " << (seconds > 0 ? evaluation.nodes / seconds : 0) << endl;
+}
+
+// usage: Bryan [perft <depth> [divide] [threads <count>] [hash <megabytes>] [FEN]]
+// the options may come in any order, and whatever is not an option is read as the FEN
+// with no arguments a depth 5 perft of the starting position is run on every hardware thread without a hash table
+void runPerft(
+	int argc,
+	char* argv[]
+) {
+	unsigned char depth = 5;
+	bool divide = false;
+	unsigned int threads = max(thread::hardware_concurrency(), 1u);
+	unsigned int hash = 0;
+	string FEN = "";
+
+	try {
+		if (argc >= 3) {
+			depth = stoi(argv[2]);
+		}
+		for (int arg = 3; arg < argc; arg++) {
+			string word = argv[arg];
+			if (word == "divide") {
+				divide = true;
+			}
+			else if (word == "threads" && arg + 1 < argc) {
+				threads = max(stoi(argv[++arg]), 1);
+			}
+			else if (word == "hash" && arg + 1 < argc) {
+				hash = max(stoi(argv[++arg]), 0);
+			}
+			else {
+				addToFEN(&FEN, word);
+			}
+		}
+	}
+	catch (const exception&) {
+		cout << PERFT_USAGE << endl;
+		return;
+	}
+
+	Position pos;
+	if (!readPosition(FEN, &pos)) {
+		cout << PERFT_USAGE << endl;
+		return;
+	}
+	pos.printBoard();
+	unique_ptr<PerftTable> table(hash ? new PerftTable(hash) : nullptr);
+
+	auto start = chrono::high_resolution_clock::now();
+
+	unsigned long long nodes = threads > 1 ?
+		Perft::parallelPerft(&pos, depth, threads, divide, table.get()) :
+		divide ? Perft::divide(&pos, depth, table.get()) : Perft::perft(&pos, depth, table.get());
+
+	auto finish = chrono::high_resolution_clock::now();
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(finish - start);
+	auto seconds = duration.count() / 1000000.0;
+
+	if (divide) {
+		cout << endl;
+	}
+	cout << "Depth: " << (int)depth << endl;
+	cout << "Threads: " << threads << endl;
+	cout << "Hash: " << hash << " MB" << endl;
+	cout << "Nodes: " << nodes << endl;
+	cout << "Seconds Elapsed: " << seconds << endl;
+	cout << "Nodes Per Second: " << (seconds > 0 ? nodes / seconds : 0) << endl;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc >= 3 && string(argv[1]) == "analyze") {
+		runAnalysis(argc, argv);
+	}
+	else {
+		runPerft(argc, argv);
+	}
 }
\ No newline at end of file
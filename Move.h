@@ -0,0 +1,70 @@
+#pragma once
+
+#include <type_traits>
+#include "Bitboard.h"
+
+using namespace std;
+
+enum MoveType : unsigned short int {
+	NORMAL = 0,
+	PROMOTION = 1 << 14,
+	EN_PASSANT = 2 << 14,
+	CASTLING = 3 << 14
+};
+
+// a move packed into 16 bits
+// bits 0-5 are the start square, bits 6-11 are the end square, bits 12-13 are the promotion piece (knight to queen) and bits 14-15 are the move type
+// castling is stored as the king's move, so white's short castle goes from e1 to g1
+struct Move {
+	unsigned short int data;
+
+	// constructs an uninitialized move so that move arrays cost nothing to create
+	Move() = default;
+
+	// constructs a move from its packed bits
+	explicit constexpr Move(unsigned short int tdata) : data(tdata) {}
+
+	// constructs a move from its parts
+	constexpr Move(
+		unsigned char start,
+		unsigned char end,
+		MoveType type = NORMAL,
+		PieceType promotion = KNIGHT
+	) : data((unsigned short int)(type | ((promotion - KNIGHT) << 12) | (end << 6) | start)) {}
+
+	// returns an empty move | no legal move goes from a square to itself
+	static constexpr Move none() {
+		return Move((unsigned short int)0);
+	}
+
+	// returns the square the piece moves from
+	unsigned char start() const {
+		return data & 0x3F;
+	}
+
+	// returns the square the piece moves to
+	unsigned char end() const {
+		return (data >> 6) & 0x3F;
+	}
+
+	// returns the kind of move
+	MoveType type() const {
+		return MoveType(data & (3 << 14));
+	}
+
+	// returns the piece a pawn promotes to | only meaningful for promotions
+	PieceType promotion() const {
+		return PieceType(((data >> 12) & 3) + KNIGHT);
+	}
+
+	bool operator==(Move other) const {
+		return data == other.data;
+	}
+
+	bool operator!=(Move other) const {
+		return data != other.data;
+	}
+};
+
+static_assert(sizeof(Move) == 2, "Move must stay 16 bits");
+static_assert(is_trivially_copyable<Move>::value, "Move must be trivially copyable");
\ No newline at end of file
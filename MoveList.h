@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Move.h"
+
+using namespace std;
+
+// a fixed capacity list of moves that lives on the stack
+// no position has more than 218 legal moves, so generation never checks the capacity
+struct MoveList {
+	Move moves[256];
+	unsigned short int count = 0;
+
+	// adds a move to the end of the list
+	void add(Move move) {
+		moves[count++] = move;
+	}
+
+	// removes every move from the list
+	void clear() {
+		count = 0;
+	}
+
+	// returns the number of moves in the list
+	unsigned short int size() const {
+		return count;
+	}
+
+	// returns true if the move is in the list
+	bool contains(Move move) const {
+		for (unsigned short int i = 0; i < count; i++) {
+			if (moves[i] == move) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Move& operator[](unsigned short int index) {
+		return moves[index];
+	}
+
+	const Move& operator[](unsigned short int index) const {
+		return moves[index];
+	}
+
+	Move* begin() {
+		return moves;
+	}
+
+	Move* end() {
+		return moves + count;
+	}
+
+	const Move* begin() const {
+		return moves;
+	}
+
+	const Move* end() const {
+		return moves + count;
+	}
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include "MovePicker.h"
+
+using namespace std;
+
+#pragma region constructors
+
+// constructs a picker for the main search that hands out every legal move
+// the two killers and the counter move are tried before the quiet moves are generated, which are then ordered by the history tables
+// continuations points to the continuation history rows of the last two moves, either of which may be nullptr
+MovePicker::MovePicker(
+	Position* tposition,
+	Move tttMove,
+	const Move* tkillers,
+	Move counterMove,
+	const History* thistory,
+	const short* const* tcontinuations
+) :
+	position(tposition),
+	stage(TT_MOVE),
+	capturesOnly(false),
+	ttMove(tttMove),
+	history(thistory)
+{
+	killers[0] = tkillers[0];
+	killers[1] = tkillers[1];
+	killers[2] = counterMove != killers[0] && counterMove != killers[1] ? counterMove : Move::none();
+	continuations[0] = tcontinuations[0];
+	continuations[1] = tcontinuations[1];
+}
+
+// constructs a picker for quiescence that hands out only the captures that do not lose material, or every legal move when in check
+MovePicker::MovePicker(
+	Position* tposition,
+	bool inCheck,
+	const History* thistory
+) :
+	position(tposition),
+	stage(GENERATE_CAPTURES),
+	capturesOnly(!inCheck),
+	ttMove(Move::none()),
+	history(thistory)
+{
+	killers[0] = killers[1] = killers[2] = Move::none();
+	continuations[0] = continuations[1] = nullptr;
+}
+
+#pragma endregion
+
+#pragma region general functions
+
+// returns the next move, or Move::none() once every move has been handed out
+Move MovePicker::next() {
+	switch (stage) {
+	case TT_MOVE:
+		stage = GENERATE_CAPTURES;
+		if (ttMove != Move::none() && position->isLegal(ttMove, legality())) {
+			return ttMove;
+		}
+		// falls through
+
+	case GENERATE_CAPTURES:
+		position->legalCaptures(&moves, legality());
+		scoreCaptures();
+		current = 0;
+		stage = GOOD_CAPTURES;
+		// falls through
+
+	case GOOD_CAPTURES:
+		while (current < moves.size()) {
+			Move move = pickBest();
+			if (move == ttMove) {
+				continue;
+			}
+
+			// the exchange is only worked out once the capture is reached
+			if (position->see(move) < 0) {
+				if (!capturesOnly) {
+					badCaptures.add(move);
+				}
+				continue;
+			}
+			return move;
+		}
+		if (capturesOnly) {
+			stage = DONE;
+			return Move::none();
+		}
+		stage = KILLERS;
+		// falls through
+
+	case KILLERS:
+		while (killerIndex < 3) {
+			Move killer = killers[killerIndex++];
+			if (killer != Move::none() && killer != ttMove && !position->isCapture(killer) && position->isLegal(killer, legality())) {
+				return killer;
+			}
+		}
+		stage = GENERATE_QUIETS;
+		// falls through
+
+	case GENERATE_QUIETS:
+		position->legalQuiets(&moves, legality());
+		scoreQuiets();
+		current = 0;
+		stage = QUIET_MOVES;
+		// falls through
+
+	case QUIET_MOVES:
+		while (current < moves.size()) {
+			Move move = pickBest();
+			if (move != ttMove && move != killers[0] && move != killers[1] && move != killers[2]) {
+				return move;
+			}
+		}
+		current = 0;
+		stage = BAD_CAPTURES;
+		// falls through
+
+	case BAD_CAPTURES:
+		if (current < badCaptures.size()) {
+			return badCaptures[current++];
+		}
+		stage = DONE;
+		// falls through
+
+	case DONE:
+		break;
+	}
+	return Move::none();
+}
+
+#pragma endregion
+
+#pragma region helper functions
+
+// returns the attack and pin information of the position, working it out the first time a stage needs it
+const LegalityMasks& MovePicker::legality() {
+	if (!masksReady) {
+		position->legalityMasks(&masks);
+		masksReady = true;
+	}
+	return masks;
+}
+
+// scores the captures by their victim and then their attacker
+void MovePicker::scoreCaptures() {
+	for (unsigned short int i = 0; i < moves.size(); i++) {
+		Move move = moves[i];
+		PieceType victim = move.type() == EN_PASSANT ? PAWN : position->pieceOn(move.end());
+		scores[i] = (victim == NO_PIECE_TYPE ? 0 : pieceValues[victim]) * 8 - position->pieceOn(move.start());
+		if (move.type() == PROMOTION) {
+			scores[i] += pieceValues[move.promotion()];
+		}
+	}
+}
+
+// scores the quiet moves by how often they and the moves leading to them were good before
+void MovePicker::scoreQuiets() {
+	Color us = position->whiteMove ? WHITE : BLACK;
+	for (unsigned short int i = 0; i < moves.size(); i++) {
+		scores[i] = 0;
+		if (!history) {
+			continue;
+		}
+
+		unsigned char start = moves[i].start();
+		unsigned char end = moves[i].end();
+		unsigned char piece = (us * 6) + position->pieceOn(start);
+		scores[i] = history->butterfly[us][start][end];
+		for (unsigned char j = 0; j < 2; j++) {
+			if (continuations[j]) {
+				scores[i] += continuations[j][(piece * 64) + end];
+			}
+		}
+	}
+}
+
+// returns the highest scored move that has not been handed out | only the moves before it are ever sorted
+Move MovePicker::pickBest() {
+	unsigned short int best = current;
+	for (unsigned short int i = current + 1; i < moves.size(); i++) {
+		if (scores[i] > scores[best]) {
+			best = i;
+		}
+	}
+	swap(moves[current], moves[best]);
+	swap(scores[current], scores[best]);
+	return moves[current++];
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Position.h"
+#include "History.h"
+
+using namespace std;
+
+// the order in which a MovePicker hands out moves
+enum PickStage : unsigned char {
+	TT_MOVE,
+	GENERATE_CAPTURES,
+	GOOD_CAPTURES,		// captures and promotions that do not lose material, most valuable victim first
+	KILLERS,
+	GENERATE_QUIETS,
+	QUIET_MOVES,
+	BAD_CAPTURES,		// captures that lose material, in the order they were found
+	DONE
+};
+
+// hands out the legal moves of a position one at a time, most promising first
+// each kind of move is only generated once the kinds before it have run out, so a cutoff on an early move skips the rest of the generation
+class MovePicker {
+public:
+
+#pragma region constructors
+
+	// constructs a picker for the main search that hands out every legal move
+	// the two killers and the counter move are tried before the quiet moves are generated, which are then ordered by the history tables
+	// continuations points to the continuation history rows of the last two moves, either of which may be nullptr
+	MovePicker(
+		Position* tposition,
+		Move tttMove,
+		const Move* tkillers,
+		Move counterMove,
+		const History* thistory,
+		const short* const* tcontinuations
+	);
+
+	// constructs a picker for quiescence that hands out only the captures that do not lose material, or every legal move when in check
+	MovePicker(
+		Position* tposition,
+		bool inCheck,
+		const History* thistory
+	);
+
+#pragma endregion
+
+#pragma region general functions
+
+	// returns the next move, or Move::none() once every move has been handed out
+	Move next();
+
+#pragma endregion
+
+private:
+
+#pragma region variables
+
+	Position* position;
+	PickStage stage;
+	bool capturesOnly;					// true if the quiet moves and losing captures are never handed out
+	Move ttMove;						// best move found by an earlier search of the position | Move::none() if unknown
+	Move killers[3];					// quiet moves that caused cutoffs in sibling positions, followed by the counter move
+	unsigned char killerIndex = 0;		// next killer to try
+	const History* history;				// orders the quiet moves | may be nullptr
+	const short* continuations[2];		// continuation history rows of the last two moves | either may be nullptr
+	MoveList moves;						// moves of the current stage
+	int scores[256];					// order of each move in moves, highest first
+	unsigned short int current = 0;		// moves before this index have been handed out
+	MoveList badCaptures;				// captures put off until after the quiet moves
+	LegalityMasks masks;				// attack and pin information shared by every stage | only valid once masksReady is set
+	bool masksReady = false;			// true once masks has been worked out
+
+#pragma endregion
+
+#pragma region helper functions
+
+	// returns the attack and pin information of the position, working it out the first time a stage needs it
+	const LegalityMasks& legality();
+
+	// scores the captures by their victim and then their attacker
+	void scoreCaptures();
+
+	// scores the quiet moves by how often they and the moves leading to them were good before
+	void scoreQuiets();
+
+	// returns the highest scored move that has not been handed out | only the moves before it are ever sorted
+	Move pickBest();
+
+#pragma endregion
+};
\ No newline at end of file
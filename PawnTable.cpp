@@ -0,0 +1,146 @@
+#include <algorithm>
+#include "PawnTable.h"
+
+using namespace std;
+
+// pawn structure terms in centipawns, indexed by the rank from the pawn's own side where there is one
+const int doubledPenalty[2] = { 10, 20 };
+const int isolatedPenalty[2] = { 10, 15 };
+const int backwardPenalty[2] = { 8, 10 };
+const int passedMidgameBonus[8] = { 0, 0, 5, 10, 20, 35, 55, 0 };
+const int passedEndgameBonus[8] = { 0, 5, 10, 20, 35, 60, 90, 0 };
+const int freePasserBonus[8] = { 0, 0, 0, 5, 10, 20, 35, 0 };
+const int shieldBonus[2] = { 10, 5 };
+
+#pragma region constructors
+
+// allocates an empty table of PAWN_TABLE_SIZE entries
+PawnTable::PawnTable() : entries(PAWN_TABLE_SIZE) {}
+
+#pragma endregion
+
+#pragma region general functions
+
+// empties the table
+// an empty entry holds the score of a board without pawns, so it is correct for a key of 0 as well
+void PawnTable::clear() {
+	fill(entries.begin(), entries.end(), PawnEntry());
+}
+
+// returns the entry for the position's pawns, evaluating them first if they are not in the table
+const PawnEntry* PawnTable::probe(Position* position) {
+	PawnEntry* entry = &entries[position->pawnKey & (PAWN_TABLE_SIZE - 1)];
+	if (entry->key != position->pawnKey) {
+		entry->key = position->pawnKey;
+		evaluatePawns(position, entry);
+	}
+	return entry;
+}
+
+// adds the pawn terms to the middlegame and endgame scores, from white's point of view
+// the structure comes from the table, and only the terms that depend on the other pieces are worked out each time
+void PawnTable::evaluate(
+	Position* position,
+	int* midgameScore,
+	int* endgameScore
+) {
+	const PawnEntry* entry = probe(position);
+	*midgameScore += entry->midgameScore + kingShield(position, WHITE) - kingShield(position, BLACK);
+	*endgameScore += entry->endgameScore + freePassers(position, entry->passed[WHITE], WHITE) - freePassers(position, entry->passed[BLACK], BLACK);
+}
+
+#pragma endregion
+
+#pragma region helper functions
+
+// fills the entry with the evaluation of the position's pawns | doubled, isolated, backward and passed pawns
+void PawnTable::evaluatePawns(
+	Position* position,
+	PawnEntry* entry
+) {
+	int midgameScore = 0;
+	int endgameScore = 0;
+	for (unsigned char color = WHITE; color <= BLACK; color++) {
+		Bitboard ours = position->pieceBoards[color][PAWN];
+		Bitboard theirs = position->pieceBoards[color ^ 1][PAWN];
+		Direction forward = color == WHITE ? UP : DOWN;
+		int sign = color == WHITE ? 1 : -1;
+		entry->passed[color] = 0;
+
+		Bitboard pawns = ours;
+		while (pawns) {
+			unsigned char square = popLsb(&pawns);
+			unsigned char col = square % 8;
+			unsigned char rank = color == WHITE ? 7 - (square / 8) : square / 8;
+			Bitboard adjacentCols = (col > 0 ? COL_A << (col - 1) : 0) | (col < 7 ? COL_A << (col + 1) : 0);
+			Bitboard front = Bitboards::rays[forward][square];
+			Bitboard frontSpan = front | (col > 0 ? Bitboards::rays[forward][square - 1] : 0) | (col < 7 ? Bitboards::rays[forward][square + 1] : 0);
+
+			// a pawn can never stand on the last rank, so the square in front of it is always on the board
+			unsigned char stop = color == WHITE ? square - 8 : square + 8;
+
+			bool doubled = (front & ours) != 0;
+			bool isolated = !(adjacentCols & ours);
+
+			// no pawn beside or behind it on the cols next to it can ever defend it, and it cannot step up to them
+			bool backward = !isolated && !(adjacentCols & ~frontSpan & ours) && (Bitboards::pawnAttacks[color][stop] & theirs);
+
+			// only the front pawn of a doubled pair counts as passed
+			bool passed = !doubled && !(frontSpan & theirs);
+
+			if (doubled) {
+				midgameScore -= sign * doubledPenalty[0];
+				endgameScore -= sign * doubledPenalty[1];
+			}
+			if (isolated) {
+				midgameScore -= sign * isolatedPenalty[0];
+				endgameScore -= sign * isolatedPenalty[1];
+			}
+			if (backward) {
+				midgameScore -= sign * backwardPenalty[0];
+				endgameScore -= sign * backwardPenalty[1];
+			}
+			if (passed) {
+				entry->passed[color] |= squareBit(square);
+				midgameScore += sign * passedMidgameBonus[rank];
+				endgameScore += sign * passedEndgameBonus[rank];
+			}
+		}
+	}
+	entry->midgameScore = (short int)midgameScore;
+	entry->endgameScore = (short int)endgameScore;
+}
+
+// returns the middlegame bonus for the pawns in front of the color's king
+int PawnTable::kingShield(
+	Position* position,
+	Color color
+) {
+	Bitboard king = position->pieceBoards[color][KING];
+	Bitboard kingCols = king | ((king << 1) & ~COL_A) | ((king >> 1) & ~COL_H);
+
+	// shifting past the edge of the board drops the squares, so a king on its last rank has no shield
+	Bitboard oneAhead = color == WHITE ? kingCols >> 8 : kingCols << 8;
+	Bitboard twoAhead = color == WHITE ? oneAhead >> 8 : oneAhead << 8;
+	Bitboard ours = position->pieceBoards[color][PAWN];
+	return (shieldBonus[0] * popCount(oneAhead & ours)) + (shieldBonus[1] * popCount(twoAhead & ours));
+}
+
+// returns the endgame bonus for the color's passed pawns that have nothing in front of them
+int PawnTable::freePassers(
+	Position* position,
+	Bitboard passed,
+	Color color
+) {
+	int score = 0;
+	Direction forward = color == WHITE ? UP : DOWN;
+	while (passed) {
+		unsigned char square = popLsb(&passed);
+		if (!(Bitboards::rays[forward][square] & position->occupied)) {
+			score += freePasserBonus[color == WHITE ? 7 - (square / 8) : square / 8];
+		}
+	}
+	return score;
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include "Position.h"
+
+using namespace std;
+
+const unsigned int PAWN_TABLE_SIZE = 16384;		// entries in each pawn table | must be a power of two
+
+// what the pawn table remembers about one pawn structure
+struct PawnEntry {
+	unsigned long long key = 0;		// pawn key of the structure
+	Bitboard passed[2] = {};		// passed pawns of each color
+	short int midgameScore = 0;		// middlegame pawn structure score from white's point of view
+	short int endgameScore = 0;		// endgame pawn structure score from white's point of view
+};
+
+// a cache of pawn structure evaluations keyed by Position::pawnKey, owned by a single search thread
+// pawns move far less often than the other pieces, so nearly every probe finds the structure already evaluated
+class PawnTable {
+public:
+
+#pragma region constructors
+
+	// allocates an empty table of PAWN_TABLE_SIZE entries
+	PawnTable();
+
+#pragma endregion
+
+#pragma region general functions
+
+	// empties the table
+	// an empty entry holds the score of a board without pawns, so it is correct for a key of 0 as well
+	void clear();
+
+	// returns the entry for the position's pawns, evaluating them first if they are not in the table
+	const PawnEntry* probe(Position* position);
+
+	// adds the pawn terms to the middlegame and endgame scores, from white's point of view
+	// the structure comes from the table, and only the terms that depend on the other pieces are worked out each time
+	void evaluate(
+		Position* position,
+		int* midgameScore,
+		int* endgameScore
+	);
+
+#pragma endregion
+
+private:
+
+#pragma region variables
+
+	vector<PawnEntry> entries;
+
+#pragma endregion
+
+#pragma region helper functions
+
+	// fills the entry with the evaluation of the position's pawns | doubled, isolated, backward and passed pawns
+	static void evaluatePawns(
+		Position* position,
+		PawnEntry* entry
+	);
+
+	// returns the middlegame bonus for the pawns in front of the color's king
+	static int kingShield(
+		Position* position,
+		Color color
+	);
+
+	// returns the endgame bonus for the color's passed pawns that have nothing in front of them
+	static int freePassers(
+		Position* position,
+		Bitboard passed,
+		Color color
+	);
+
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include <iostream>
+#include "Perft.h"
+
+using namespace std;
+
+namespace Perft {
+
+	// returns the number of leaf nodes at the given depth
+	// the last ply is bulk counted, so the moves leading to leaf nodes are generated but never played
+	// subtree counts are cached in table when one is given
+	unsigned long long perft(
+		Position* position,
+		unsigned char depth,
+		PerftTable* table
+	) {
+		if (depth == 0) {
+			return 1;
+		}
+
+		unsigned long long nodes = 0;
+		if (table && depth >= 2 && table->probe(position->key, depth, &nodes)) {
+			return nodes;
+		}
+
+		MoveList moves;
+		position->legalMoves(&moves);
+		if (depth == 1) {
+			return moves.size();
+		}
+
+		for (unsigned short int i = 0; i < moves.size(); i++) {
+			Undo undo = position->makeMove(moves[i]);
+			nodes += perft(position, depth - 1, table);
+			position->unmakeMove(moves[i], undo);
+		}
+
+		if (table) {
+			table->store(position->key, depth, nodes);
+		}
+		return nodes;
+	}
+
+	// prints the number of leaf nodes below each root move and returns the total
+	unsigned long long divide(
+		Position* position,
+		unsigned char depth,
+		PerftTable* table
+	) {
+		if (depth == 0) {
+			return 1;
+		}
+
+		MoveList moves;
+		position->legalMoves(&moves);
+
+		unsigned long long nodes = 0;
+		for (unsigned short int i = 0; i < moves.size(); i++) {
+			Undo undo = position->makeMove(moves[i]);
+			unsigned long long moveNodes = perft(position, depth - 1, table);
+			position->unmakeMove(moves[i], undo);
+
+			cout << Position::uciMove(moves[i]) << ": " << moveNodes << endl;
+			nodes += moveNodes;
+		}
+		return nodes;
+	}
+
+	// returns the number of leaf nodes at the given depth, counted by a pool of threads
+	// the tree is split below the second ply and every task counts its subtree on its own copy of the position
+	// the count below each root move is printed when printDivide is true
+	// subtree counts are cached in table when one is given, which every thread shares
+	unsigned long long parallelPerft(
+		Position* position,
+		unsigned char depth,
+		unsigned int threads,
+		bool printDivide,
+		PerftTable* table
+	) {
+
+		// shallow trees are not worth splitting
+		if (depth < 3) {
+			return printDivide ? divide(position, depth, table) : perft(position, depth, table);
+		}
+
+		MoveList rootMoves;
+		position->legalMoves(&rootMoves);
+		vector<atomic<unsigned long long>> rootNodes(rootMoves.size());
+		for (unsigned short int i = 0; i < rootMoves.size(); i++) {
+			rootNodes[i] = 0;
+		}
+
+		{
+			ThreadPool pool(threads);
+			for (unsigned short int i = 0; i < rootMoves.size(); i++) {
+				Undo rootUndo = position->makeMove(rootMoves[i]);
+				MoveList replies;
+				position->legalMoves(&replies);
+				for (unsigned short int j = 0; j < replies.size(); j++) {
+					Position child = *position;
+					child.makeMove(replies[j]);
+					atomic<unsigned long long>* count = &rootNodes[i];
+					pool.submit([child, depth, count, table]() mutable {
+						*count += perft(&child, depth - 2, table);
+					});
+				}
+				position->unmakeMove(rootMoves[i], rootUndo);
+			}
+			pool.wait();
+		}
+
+		unsigned long long nodes = 0;
+		for (unsigned short int i = 0; i < rootMoves.size(); i++) {
+			if (printDivide) {
+				cout << Position::uciMove(rootMoves[i]) << ": " << rootNodes[i] << endl;
+			}
+			nodes += rootNodes[i];
+		}
+		return nodes;
+	}
+}
\ No newline at end of file
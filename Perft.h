@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Position.h"
+#include "ThreadPool.h"
+#include "PerftTable.h"
+
+using namespace std;
+
+// counts the leaf nodes of the legal move tree to test the speed and correctness of move generation
+namespace Perft {
+
+	// returns the number of leaf nodes at the given depth
+	// the last ply is bulk counted, so the moves leading to leaf nodes are generated but never played
+	// subtree counts are cached in table when one is given
+	unsigned long long perft(
+		Position* position,
+		unsigned char depth,
+		PerftTable* table = nullptr
+	);
+
+	// prints the number of leaf nodes below each root move and returns the total
+	unsigned long long divide(
+		Position* position,
+		unsigned char depth,
+		PerftTable* table = nullptr
+	);
+
+	// returns the number of leaf nodes at the given depth, counted by a pool of threads
+	// the tree is split below the second ply and every task counts its subtree on its own copy of the position
+	// the count below each root move is printed when printDivide is true
+	// subtree counts are cached in table when one is given, which every thread shares
+	unsigned long long parallelPerft(
+		Position* position,
+		unsigned char depth,
+		unsigned int threads,
+		bool printDivide = false,
+		PerftTable* table = nullptr
+	);
+}
\ No newline at end of file
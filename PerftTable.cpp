@@ -0,0 +1,53 @@
+#include "PerftTable.h"
+
+using namespace std;
+
+#pragma region constructors
+
+// allocates a table using about the given number of megabytes
+PerftTable::PerftTable(unsigned int megabytes) {
+	unsigned long long count = 1;
+	while (count * 2 * sizeof(Entry) <= (unsigned long long)megabytes << 20) {
+		count *= 2;
+	}
+	entries.reset(new Entry[count]);
+	mask = count - 1;
+	for (unsigned long long i = 0; i < count; i++) {
+		entries[i].check.store(0, memory_order_relaxed);
+		entries[i].data.store(0, memory_order_relaxed);
+	}
+}
+
+#pragma endregion
+
+#pragma region general functions
+
+// returns true and sets nodes if the subtree of the position was counted to the given depth
+bool PerftTable::probe(
+	unsigned long long key,
+	unsigned char depth,
+	unsigned long long* nodes
+) {
+	Entry& entry = entries[key & mask];
+	unsigned long long check = entry.check.load(memory_order_relaxed);
+	unsigned long long data = entry.data.load(memory_order_relaxed);
+	if ((check ^ data) != key || (data & 0xFF) != depth) {
+		return false;
+	}
+	*nodes = data >> 8;
+	return true;
+}
+
+// stores the number of leaf nodes of the position's subtree at the given depth
+void PerftTable::store(
+	unsigned long long key,
+	unsigned char depth,
+	unsigned long long nodes
+) {
+	Entry& entry = entries[key & mask];
+	unsigned long long data = (nodes << 8) | depth;
+	entry.check.store(key ^ data, memory_order_relaxed);
+	entry.data.store(data, memory_order_relaxed);
+}
+
+#pragma endregion
\ No newline at end of file
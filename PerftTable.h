@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+// a fixed size cache of perft subtree counts keyed by zobrist key and remaining depth
+// it is shared between perft threads without locks: every entry stores its key xored with its data,
+// so an entry torn by two threads writing at once fails the key check instead of returning a wrong count
+class PerftTable {
+public:
+
+#pragma region constructors
+
+	// allocates a table using about the given number of megabytes
+	PerftTable(unsigned int megabytes);
+
+#pragma endregion
+
+#pragma region general functions
+
+	// returns true and sets nodes if the subtree of the position was counted to the given depth
+	bool probe(
+		unsigned long long key,
+		unsigned char depth,
+		unsigned long long* nodes
+	);
+
+	// stores the number of leaf nodes of the position's subtree at the given depth
+	void store(
+		unsigned long long key,
+		unsigned char depth,
+		unsigned long long nodes
+	);
+
+#pragma endregion
+
+private:
+
+	// the low 8 bits of data are the depth and the rest are the node count
+	struct Entry {
+		atomic<unsigned long long> check;	// key xored with data
+		atomic<unsigned long long> data;
+	};
+
+#pragma region variables
+
+	unique_ptr<Entry[]> entries;	// the table, with a power of two size
+	unsigned long long mask;		// entry count minus one, used to index by key
+
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Bitboard.h"
+
+using namespace std;
+
+// material and piece square values, one set for the middlegame and one for the endgame
+// Position keeps the sums of both up to date as pieces move, and the evaluation blends them by how much material is left
+namespace PieceSquare {
+
+	const int MAX_PHASE = 24;							// phase of the starting position | the middlegame values count in full at this phase and the endgame values at 0
+	const int phaseWeights[6] = { 0, 1, 1, 2, 4, 0 };	// how much each piece type adds to the phase
+
+#pragma region tables
+
+	// middlegame value of each piece type of each color on each square, including its material | black's values are negative
+	extern int midgame[2][6][64];
+
+	// endgame value of each piece type of each color on each square, including its material | black's values are negative
+	extern int endgame[2][6][64];
+
+#pragma endregion
+
+#pragma region functions
+
+	// fills the tables | called once by Position::initTables
+	void init();
+
+	// returns the blend of a middlegame and an endgame score for the given phase
+	inline int taper(
+		int midgameScore,
+		int endgameScore,
+		int phase
+	) {
+		phase = phase < MAX_PHASE ? phase : MAX_PHASE;
+		return ((midgameScore * phase) + (endgameScore * (MAX_PHASE - phase))) / MAX_PHASE;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
@@ -1,8 +1,22 @@
+#include <algorithm>
 #include <iostream>
 #include "Position.h"
 
 using namespace std;
 
+// castle rights that remain after a piece moves from or to each square
+// moving the king or a rook, or capturing a rook, removes the matching rights
+const unsigned char castleMasks[64] = {
+	15 ^ BLACK_LONG, 15, 15, 15, 15 ^ (BLACK_SHORT | BLACK_LONG), 15, 15, 15 ^ BLACK_SHORT,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15, 15, 15, 15, 15, 15, 15, 15,
+	15 ^ WHITE_LONG, 15, 15, 15, 15 ^ (WHITE_SHORT | WHITE_LONG), 15, 15, 15 ^ WHITE_SHORT
+};
+
 #pragma region constructors
 
 // constructs a position with default attributes
@@ -23,8 +37,6 @@ Position::Position(
 	unsigned short int tmoveCount
 ) : 
 	whiteMove(twhiteMove),
-	castle(tcastle),
-	ep(tep),
 	fiftyMoveRule(tfiftyMoveRule),
 	moveCount(tmoveCount)
 {
@@ -33,6 +45,11 @@ Position::Position(
 			board[row][col] = tboard[row][col];
 		}
 	}
+	for (unsigned char i = 0; i < tcastle.length(); i++) {
+		castle |= tcastle.at(i) == 'K' ? WHITE_SHORT : tcastle.at(i) == 'Q' ? WHITE_LONG : tcastle.at(i) == 'k' ? BLACK_SHORT : tcastle.at(i) == 'q' ? BLACK_LONG : 0;
+	}
+	ep = tep == "-" ? 64 : rowColToChar(56 - tep.at(1), tep.at(0) - 97);
+	setBitboards();
 }
 
 #pragma endregion
@@ -44,6 +61,13 @@ Position Position::StartingPosition() {
 	return Position("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
 }
 
+// fills the attack, zobrist and piece square tables, in that order | only the first call does anything
+// every position that is set up calls this, so the tables are ready before any position uses them
+void Position::initTables() {
+	static bool initialized = (Bitboards::init(), Zobrist::init(), PieceSquare::init(), true);
+	(void)initialized;
+}
+
 // generates an FEN based on the board position
 string Position::FEN() {
 
@@ -75,8 +99,26 @@ string Position::FEN() {
 	out += " ";
 	out += whiteMove ? "w" : "b";
 
-	// adds the castle moves, en passant move, fifty move rule counter and overall move counter
-	out += " " + castle + " " + ep + " " + to_string(fiftyMoveRule) + " " + to_string(moveCount);
+	// adds the castle moves
+	out += " ";
+	if (castle & WHITE_SHORT) {
+		out += "K";
+	}
+	if (castle & WHITE_LONG) {
+		out += "Q";
+	}
+	if (castle & BLACK_SHORT) {
+		out += "k";
+	}
+	if (castle & BLACK_LONG) {
+		out += "q";
+	}
+	if (!castle) {
+		out += "-";
+	}
+
+	// adds the en passant move, fifty move rule counter and overall move counter
+	out += " " + (ep < 64 ? squareName(ep) : "-") + " " + to_string(fiftyMoveRule) + " " + to_string(moveCount);
 	return out;
 }
 
@@ -116,15 +158,19 @@ void Position::setToFEN(string FEN) {
 	while (FEN.at(num) != ' ') {
 		num++;
 	}
-	castle = FEN.substr(count, num - count);
+	castle = 0;
+	for (; count < num; count++) {
+		item = FEN.at(count);
+		castle |= item == 'K' ? WHITE_SHORT : item == 'Q' ? WHITE_LONG : item == 'k' ? BLACK_SHORT : item == 'q' ? BLACK_LONG : 0;
+	}
 	count = num + 1;
 
 	// sets the en passant square
 	if (FEN.at(count) == '-') {
-		ep = "-";
+		ep = 64;
 	}
 	else {
-		ep = FEN.substr(count, 2);
+		ep = rowColToChar(56 - FEN.at(count + 1), FEN.at(count) - 97);
 		count++;
 	}
 	count += 2;
@@ -139,284 +185,339 @@ void Position::setToFEN(string FEN) {
 
 	// sets the move count
 	moveCount = stoi(FEN.substr(count, FEN.length()));
+
+	setBitboards();
 }
 
-// returns a list of legal moves
-vector<string> Position::legalMoves() {
-	vector<string> moves;
-	unsigned char check = 64;
-	bool doubleCheck = false;
-	unsigned char kingRow;
-	unsigned char kingCol;
-	unordered_set<unsigned char> kingDangerSquares;
-	unordered_set<unsigned char> pinnedPieces;
+// fills moves with the legal moves
+void Position::legalMoves(MoveList* moves) {
+	LegalityMasks masks;
+	legalityMasks(&masks);
+	generateLegal(moves, ALL_MOVES, masks);
+}
 
-#pragma region generate attacked squares
+// fills moves with the legal captures and promotions | quiet moves are never generated, so this is much cheaper than legalMoves
+void Position::legalCaptures(MoveList* moves) {
+	LegalityMasks masks;
+	legalityMasks(&masks);
+	generateLegal(moves, CAPTURES, masks);
+}
 
-	for (unsigned char row = 0; row < 8; row++) {
-		for (unsigned char col = 0; col < 8; col++) {
-			char currentPiece = board[row][col];
-			if (whiteMove ? islower(currentPiece) : isupper(currentPiece)) {
-				switch (whiteMove ? currentPiece : currentPiece + 32) {
-				case 'k':
-					kingAttack(
-						row,
-						col,
-						&kingDangerSquares
-					);
-					break;
-				case 'q':
-					bishopAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares,
-						&pinnedPieces
-					);
-					rookAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares,
-						&pinnedPieces
-					);
-					break;
-				case 'b':
-					bishopAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares,
-						&pinnedPieces
-					);
-					break;
-				case 'n':
-					knightAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares
-					);
-					break;
-				case 'r':
-					rookAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares,
-						&pinnedPieces
-					);
-					break;
-				case 'p':
-					pawnAttack(
-						row,
-						col,
-						&check,
-						&doubleCheck,
-						&kingDangerSquares
-					);
-					break;
-				}
-			}
-			else if (currentPiece == (whiteMove ? 'K' : 'k')) {
-				kingRow = row;
-				kingCol = col;
-			}
-		}
-	}
+// fills moves with the legal captures and promotions, using masks already worked out for this position
+void Position::legalCaptures(
+	MoveList* moves,
+	const LegalityMasks& masks
+) {
+	generateLegal(moves, CAPTURES, masks);
+}
 
-#pragma endregion
-	
-	generateKingMoves(
-		kingRow,
-		kingCol,
-		&moves,
-		&kingDangerSquares
-	);
+// returns true if the side to move is in check
+bool Position::inCheck() {
+	Color us = whiteMove ? WHITE : BLACK;
+	return (attackersTo(lsb(pieceBoards[us][KING]), occupied) & colorBoards[whiteMove ? BLACK : WHITE]) != 0;
+}
 
-	if (doubleCheck) {
-		return moves;
-	}
+// fills moves with the legal moves that are not captures or promotions
+void Position::legalQuiets(MoveList* moves) {
+	LegalityMasks masks;
+	legalityMasks(&masks);
+	generateLegal(moves, QUIETS, masks);
+}
 
-	vector<string> pseudoLegalMoves;
+// fills moves with the legal moves that are not captures or promotions, using masks already worked out for this position
+void Position::legalQuiets(
+	MoveList* moves,
+	const LegalityMasks& masks
+) {
+	generateLegal(moves, QUIETS, masks);
+}
 
-#pragma region generate pseudo legal moves
+// returns true if the move is legal in this position
+// used for moves that come from somewhere other than the generator, like the transposition table
+bool Position::isLegal(Move move) {
+	LegalityMasks masks;
+	legalityMasks(&masks);
+	return isLegal(move, masks);
+}
 
-	for (unsigned char row = 0; row < 8; row++) {
-		for (unsigned char col = 0; col < 8; col++) {
-			char currentPiece = board[row][col];
-			if (whiteMove ? isupper(currentPiece) : islower(currentPiece)) {
-				switch (whiteMove ? currentPiece + 32 : currentPiece) {
-				case 'q':
-					generateBishopMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateRookMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					break;
-				case 'b':
-					generateBishopMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					break;
-				case 'n':
-					generateKnightMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					break;
-				case 'r':
-					generateRookMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					break;
-				case 'p':
-					generatePawnMoves(
-						row,
-						col,
-						&pseudoLegalMoves,
-						&pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					break;
-				}
-			}
-		}
+// returns true if the move is legal in this position, using masks already worked out for it
+bool Position::isLegal(
+	Move move,
+	const LegalityMasks& masks
+) {
+	Color us = whiteMove ? WHITE : BLACK;
+	if (move == Move::none() || !(colorBoards[us] & squareBit(move.start()))) {
+		return false;
 	}
 
-#pragma endregion
+	// only the moves of the piece that would make it are generated
+	MoveList moves;
+	generateLegal(&moves, ALL_MOVES, masks, squareBit(move.start()));
+	return moves.contains(move);
+}
 
-#pragma region add correct pseudo legal moves to moves
+// fills masks with the attack and pin information of this position
+void Position::legalityMasks(LegalityMasks* masks) {
+	Color us = whiteMove ? WHITE : BLACK;
+	Color them = whiteMove ? BLACK : WHITE;
+	masks->kingSquare = lsb(pieceBoards[us][KING]);
+
+	// the attacks pass through the king so that the king cannot step backwards along a slider's line
+	masks->kingDangerSquares = attackedSquares(them, occupied ^ pieceBoards[us][KING]);
+	masks->checkers = attackersTo(masks->kingSquare, occupied) & colorBoards[them];
+	masks->pinned = pinnedPieces(us);
+	masks->checkMask = masks->checkers ? Bitboards::between[masks->kingSquare][lsb(masks->checkers)] | masks->checkers : ~0ULL;
+}
 
-	if (check < 64) {
-		unsigned char attackerRow = check / 8;
-		unsigned char attackerCol = check % 8;
-		char attacker = board[attackerRow][attackerCol];
-		if (
-			attacker != (whiteMove ? 'n' : 'N') &&
-			(abs(attackerRow - kingRow) >= 2 || abs(attackerCol - kingCol) >= 2)
-		) {
-				// check if attacker can be blocked
-				// notes:
-				// pinned pieces cannot block check
-				// en passant cannot block check
-			for (unsigned char i = 0; i < pseudoLegalMoves.size(); i++) {
-				string move = pseudoLegalMoves.at(i);
-				unsigned char endMoveRow = move.at(2);
-				unsigned char endMoveCol = move.at(3);
-				unsigned char minRow = min(kingRow, attackerRow);
-				unsigned char minCol = min(kingCol, attackerCol);
-				unsigned char maxRow = max(kingRow, attackerRow);
-				unsigned char maxCol = max(kingCol, attackerCol);
-				if (
-					onLine(
-						kingRow,
-						kingCol,
-						attackerRow,
-						attackerCol,
-						endMoveRow,
-						endMoveCol
-					) &&
-					(isBetween(endMoveRow, minRow, maxRow) || isBetween(endMoveCol, minCol, maxCol))
-				) {
-					moves.push_back(move);
-				}
-			}
+// returns true if the move captures a piece or promotes a pawn
+bool Position::isCapture(Move move) {
+	return move.type() == EN_PASSANT || move.type() == PROMOTION || (move.type() != CASTLING && (occupied & squareBit(move.end())));
+}
+
+// returns the type of the piece on a square | NO_PIECE_TYPE if it is empty
+PieceType Position::pieceOn(unsigned char square) {
+	return pieceType(board[square / 8][square % 8]);
+}
+
+// returns the pieces of both colors that attack the square
+// pieces missing from occupancy are treated as gone, so sliders behind them are found as well
+Bitboard Position::attackersTo(
+	unsigned char square,
+	Bitboard occupancy
+) {
+	return
+		(Bitboards::pawnAttacks[BLACK][square] & pieceBoards[WHITE][PAWN]) |
+		(Bitboards::pawnAttacks[WHITE][square] & pieceBoards[BLACK][PAWN]) |
+		(Bitboards::knightAttacks[square] & (pieceBoards[WHITE][KNIGHT] | pieceBoards[BLACK][KNIGHT])) |
+		(Bitboards::kingAttacks[square] & (pieceBoards[WHITE][KING] | pieceBoards[BLACK][KING])) |
+		(Bitboards::bishopAttacks(square, occupancy) & (
+			pieceBoards[WHITE][BISHOP] | pieceBoards[BLACK][BISHOP] |
+			pieceBoards[WHITE][QUEEN] | pieceBoards[BLACK][QUEEN]
+		)) |
+		(Bitboards::rookAttacks(square, occupancy) & (
+			pieceBoards[WHITE][ROOK] | pieceBoards[BLACK][ROOK] |
+			pieceBoards[WHITE][QUEEN] | pieceBoards[BLACK][QUEEN]
+		));
+}
+
+// returns the material the side to move wins in centipawns if both sides keep capturing on the move's end square, each with its least valuable piece
+// either side may stop capturing when it would lose material | pins are ignored
+int Position::see(Move move) {
+	if (move.type() == CASTLING) {
+		return 0;
+	}
+
+	unsigned char start = move.start();
+	unsigned char end = move.end();
+	Color side = whiteMove ? BLACK : WHITE;
+	PieceType captured = move.type() == EN_PASSANT ? PAWN : pieceOn(end);
+	PieceType attacker = pieceOn(start);
+	Bitboard occupancy = occupied ^ squareBit(start);
+	if (move.type() == EN_PASSANT) {
+		occupancy ^= squareBit(whiteMove ? end + 8 : end - 8);
+	}
+
+	// gains[i] is what the side making capture i wins if the sequence stops after it
+	int gains[32];
+	gains[0] = captured == NO_PIECE_TYPE ? 0 : pieceValues[captured];
+	if (move.type() == PROMOTION) {
+		attacker = move.promotion();
+		gains[0] += pieceValues[attacker] - pieceValues[PAWN];
+	}
+
+	Bitboard diagonals = pieceBoards[WHITE][BISHOP] | pieceBoards[BLACK][BISHOP] | pieceBoards[WHITE][QUEEN] | pieceBoards[BLACK][QUEEN];
+	Bitboard straights = pieceBoards[WHITE][ROOK] | pieceBoards[BLACK][ROOK] | pieceBoards[WHITE][QUEEN] | pieceBoards[BLACK][QUEEN];
+	Bitboard attackers = attackersTo(end, occupancy) & occupancy;
+	unsigned char depth = 0;
+	while (true) {
+		Bitboard ours = attackers & colorBoards[side];
+		if (!ours) {
+			break;
 		}
 
-		// check if attacker can be captured
-		for (unsigned char i = 0; i < pseudoLegalMoves.size(); i++) {
-			string move = pseudoLegalMoves.at(i);
-			unsigned char endMoveRow = move.at(2);
-			unsigned char endMoveCol = move.at(3);
-			if (endMoveCol == attackerCol) {
-
-				if (move.length() == 5 && move.at(4) == 'e') {
-
-					// en passant
-					if (
-						56 - ep.at(1) + (whiteMove ? 1 : -1) == attackerRow &&
-						ep.at(0) - 97 == attackerCol
-					) {
-						moves.push_back(move);
-					}
-				}
-				else if (endMoveRow == attackerRow) {
-					moves.push_back(move);
-				}
-			}
+		unsigned char type = PAWN;
+		while (!(ours & pieceBoards[side][type])) {
+			type++;
 		}
-	}
-	else {
-		moves.insert(moves.end(), pseudoLegalMoves.begin(), pseudoLegalMoves.end());
-	}
 
-#pragma endregion
+		// the king cannot capture a defended piece
+		if (type == KING && (attackers & colorBoards[side ^ 1])) {
+			break;
+		}
 
-#pragma region castle
-	if (check == 64) {
-		if (castle.find(whiteMove ? 'K' : 'k') != string::npos) {
-			signed char direction = whiteMove ? 1 : -1;
-			unsigned char kingColAndDirection = kingCol + direction;
-			unsigned char kingColAndDoubleDirection = kingColAndDirection + direction;
-			if (
-				!kingDangerSquares.count(rowColToChar(kingRow, kingColAndDirection)) &&
-				!kingDangerSquares.count(rowColToChar(kingRow, kingColAndDoubleDirection)) &&
-				board[kingRow][kingColAndDirection] == '-' &&
-				board[kingRow][kingColAndDoubleDirection] == '-'
-			) {
-				moves.push_back("O-O");
-			}
+		depth++;
+		gains[depth] = pieceValues[attacker] - gains[depth - 1];
+		attacker = PieceType(type);
+		occupancy ^= squareBit(lsb(ours & pieceBoards[side][type]));
+
+		// the capturing piece may uncover a slider behind it
+		if (type == PAWN || type == BISHOP || type == QUEEN) {
+			attackers |= Bitboards::bishopAttacks(end, occupancy) & diagonals;
 		}
-		if (castle.find(whiteMove ? 'Q' : 'q') != string::npos) {
-			signed char direction = whiteMove ? -1 : 1;
-			unsigned char kingColAndDirection = kingCol + direction;
-			unsigned char kingColAndDoubleDirection = kingColAndDirection + direction;
-			if (
-				!kingDangerSquares.count(rowColToChar(kingRow, kingColAndDirection)) &&
-				!kingDangerSquares.count(rowColToChar(kingRow, kingColAndDoubleDirection)) &&
-				board[kingRow][kingColAndDirection] == '-' &&
-				board[kingRow][kingColAndDoubleDirection] == '-'
-			) {
-				moves.push_back("O-O-O");
-			}
+		if (type == ROOK || type == QUEEN) {
+			attackers |= Bitboards::rookAttacks(end, occupancy) & straights;
 		}
+		attackers &= occupancy;
+		side = Color(side ^ 1);
 	}
 
-#pragma endregion
+	// each side only makes a capture if it does better than stopping
+	while (depth) {
+		gains[depth - 1] = -max(-gains[depth - 1], gains[depth]);
+		depth--;
+	}
+	return gains[0];
+}
+
+// plays a legal move and returns what is needed to undo it
+Undo Position::makeMove(Move move) {
+	Undo undo;
+	undo.captured = '-';
+	undo.castle = castle;
+	undo.ep = ep;
+	undo.fiftyMoveRule = fiftyMoveRule;
+	undo.key = key;
+
+	unsigned char start = move.start();
+	unsigned char end = move.end();
+	char piece = board[start / 8][start % 8];
+	fiftyMoveRule++;
+	if (ep < 64) {
+		key ^= Zobrist::ep[ep % 8];
+		ep = 64;
+	}
+
+	switch (move.type()) {
+	case CASTLING: {
+		bool shortCastle = end > start;
+		movePiece(start, end);
+		movePiece(shortCastle ? start + 3 : start - 4, shortCastle ? start + 1 : start - 1);
+		break;
+	}
+	case EN_PASSANT: {
+		unsigned char captured = whiteMove ? end + 8 : end - 8;
+		undo.captured = board[captured / 8][captured % 8];
+		removePiece(captured);
+		movePiece(start, end);
+		fiftyMoveRule = 0;
+		break;
+	}
+	default:
+		if (board[end / 8][end % 8] != '-') {
+			undo.captured = board[end / 8][end % 8];
+			removePiece(end);
+			fiftyMoveRule = 0;
+		}
+		movePiece(start, end);
+
+		if (pieceType(piece) == PAWN) {
+			fiftyMoveRule = 0;
+
+			// the en passant square is only set when an enemy pawn can capture on it
+			if (start - end == 16 || end - start == 16) {
+				unsigned char passed = (start + end) / 2;
+				if (Bitboards::pawnAttacks[whiteMove ? WHITE : BLACK][passed] & pieceBoards[whiteMove ? BLACK : WHITE][PAWN]) {
+					ep = passed;
+					key ^= Zobrist::ep[ep % 8];
+				}
+			}
+			else if (move.type() == PROMOTION) {
+				removePiece(end);
+				putPiece(end, whiteMove ? "NBRQ"[move.promotion() - KNIGHT] : "nbrq"[move.promotion() - KNIGHT]);
+			}
+		}
+	}
+
+	key ^= Zobrist::castle[castle];
+	castle &= castleMasks[start] & castleMasks[end];
+	key ^= Zobrist::castle[castle] ^ Zobrist::blackMove;
+	if (!whiteMove) {
+		moveCount++;
+	}
+	whiteMove = !whiteMove;
+	return undo;
+}
+
+// takes back a move played by makeMove
+void Position::unmakeMove(
+	Move move,
+	const Undo& undo
+) {
+	whiteMove = !whiteMove;
+	if (!whiteMove) {
+		moveCount--;
+	}
+
+	unsigned char start = move.start();
+	unsigned char end = move.end();
+
+	switch (move.type()) {
+	case CASTLING: {
+		bool shortCastle = end > start;
+		movePiece(end, start);
+		movePiece(shortCastle ? start + 1 : start - 1, shortCastle ? start + 3 : start - 4);
+		break;
+	}
+	case EN_PASSANT:
+		movePiece(end, start);
+		putPiece(whiteMove ? end + 8 : end - 8, undo.captured);
+		break;
+	case PROMOTION:
+		removePiece(end);
+		putPiece(start, whiteMove ? 'P' : 'p');
+		if (undo.captured != '-') {
+			putPiece(end, undo.captured);
+		}
+		break;
+	default:
+		movePiece(end, start);
+		if (undo.captured != '-') {
+			putPiece(end, undo.captured);
+		}
+	}
+
+	castle = undo.castle;
+	ep = undo.ep;
+	fiftyMoveRule = undo.fiftyMoveRule;
+	key = undo.key;
+}
+
+// passes the turn to the other side without moving and returns what is needed to undo it | must not be called when in check
+Undo Position::makeNullMove() {
+	Undo undo;
+	undo.captured = '-';
+	undo.castle = castle;
+	undo.ep = ep;
+	undo.fiftyMoveRule = fiftyMoveRule;
+	undo.key = key;
+
+	fiftyMoveRule++;
+	if (ep < 64) {
+		key ^= Zobrist::ep[ep % 8];
+		ep = 64;
+	}
+	key ^= Zobrist::blackMove;
+	if (!whiteMove) {
+		moveCount++;
+	}
+	whiteMove = !whiteMove;
+	return undo;
+}
 
-	return moves;
+// takes back a turn passed by makeNullMove
+void Position::unmakeNullMove(const Undo& undo) {
+	whiteMove = !whiteMove;
+	if (!whiteMove) {
+		moveCount--;
+	}
+	ep = undo.ep;
+	fiftyMoveRule = undo.fiftyMoveRule;
+	key = undo.key;
+}
+
+// returns true if the color has a knight, bishop, rook or queen
+bool Position::hasPieces(Color color) {
+	return (colorBoards[color] & ~pieceBoards[color][PAWN] & ~pieceBoards[color][KING]) != 0;
 }
 
 // prints the board to the console
@@ -433,3518 +534,456 @@ void Position::printBoard() {
 }
 
 // returns a string representing a move that is more readable for humans
-string Position::translateMove(string move) {
-	if (move == "O-O" || move == "O-O-O") {
-		return move;
+string Position::translateMove(Move move) {
+	if (move == Move::none()) {
+		return "none";
 	}
-	string out = "";
-	out += (move.at(0) % 8) + 97;
-	out += to_string(8 - (move.at(0) / 8));
-	out += '-';
-	out += (move.at(1) % 8) + 97;
-	out += to_string(8 - (move.at(1) / 8));
-
-	if (move.length() == 3) {
-		if (move.at(2) == 'e') {
-			out += " ep";
-		}
-		else {
-			out += '=';
-			out += move.at(2);
-		}
+	if (move.type() == CASTLING) {
+		return move.end() % 8 == 6 ? "O-O" : "O-O-O";
 	}
+	string out = squareName(move.start()) + "-" + squareName(move.end());
 
-	return out;
-}
-
-#pragma endregion
-
-#pragma region helper functions
-
-// sets squares which are attacked by the enemy king
-void Position::kingAttack(
-	unsigned char row,
-	unsigned char col,
-	unordered_set<unsigned char>* kingDangerSquares
-) {
-	if (row == 0) {
-		unsigned char rowBottom = row + 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colRight));
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colLeft));
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colRight));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colLeft));
-		}
-	}
-	else if (row == 7) {
-		unsigned char rowTop = row - 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colRight));
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colLeft));
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colRight));
-			kingDangerSquares->insert(rowColToChar(rowTop, colLeft));
-		}
+	if (move.type() == EN_PASSANT) {
+		out += " ep";
 	}
-	else {
-		unsigned char rowTop = row - 1;
-		unsigned char rowBottom = row + 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colRight));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colRight));
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colLeft));
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			kingDangerSquares->insert(rowColToChar(row, colRight));
-			kingDangerSquares->insert(rowColToChar(row, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowTop, col));
-			kingDangerSquares->insert(rowColToChar(rowTop, colRight));
-			kingDangerSquares->insert(rowColToChar(rowTop, colLeft));
-			kingDangerSquares->insert(rowColToChar(rowBottom, col));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colRight));
-			kingDangerSquares->insert(rowColToChar(rowBottom, colLeft));
-		}
+	else if (move.type() == PROMOTION) {
+		out += '=';
+		out += "NBRQ"[move.promotion() - KNIGHT];
 	}
+
+	return out;
 }
 
-// sets squares which are attacked by the enemy bishops
-void Position::bishopAttack(
-	unsigned char row,
-	unsigned char col,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares,
-	unordered_set<unsigned char>* pinnedPieces
-) {
-	unsigned char topLeftMax = min(row, col);
-	unsigned char topRightMax = min(row, unsigned char(7 - col));
-	unsigned char bottomRightMax = min(unsigned char(7 - row), unsigned char(7 - col));
-	unsigned char bottomLeftMax = min(unsigned char(7 - row), col);
-	unsigned char pin = 64;
-
-	// attack squares up and left
-	for (unsigned char topLeft = 1; topLeft <= topLeftMax; topLeft++) {
-		if (sliderAttack(
-			row,
-			col,
-			row - topLeft,
-			col - topLeft,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
-	}
-	pin = 64;
-
-	// attack squares up and right
-	for (unsigned char topRight = 1; topRight <= topRightMax; topRight++) {
-		if (sliderAttack(
-			row,
-			col,
-			row - topRight,
-			col + topRight,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
-	}
-	pin = 64;
-
-	//attack squares down and left
-	for (unsigned char bottomLeft = 1; bottomLeft <= bottomLeftMax; bottomLeft++) {
-		if (sliderAttack(
-			row,
-			col,
-			row + bottomLeft,
-			col - bottomLeft,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
-	}
-	pin = 64;
-
-	// attack squares down and right
-	for (unsigned char bottomRight = 1; bottomRight <= bottomRightMax; bottomRight++) {
-		if (sliderAttack(
-			row,
-			col,
-			row + bottomRight,
-			col + bottomRight,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
+// returns a move in the notation used by UCI, for example "e2e4" or "e7e8q"
+string Position::uciMove(Move move) {
+	string out = squareName(move.start()) + squareName(move.end());
+	if (move.type() == PROMOTION) {
+		out += "nbrq"[move.promotion() - KNIGHT];
 	}
+	return out;
 }
 
-// sets squares which are attacked by the enemy knights
-void Position::knightAttack(
-	unsigned char row,
-	unsigned char col,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares
-) {
-	if (row <= 1) {
-		if (row == 0) {
-			if (col <= 1) {
-
-				// row = 0 | col = 0
-				if (col == 0) {
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						1,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						1,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
+// returns the name of a square, for example "e4"
+string Position::squareName(unsigned char square) {
+	string out = "";
+	out += (square % 8) + 97;
+	out += to_string(8 - (square / 8));
+	return out;
+}
 
-				// row = 0 | col = 1
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						0,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						1,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 0 | col = 7
-				if (col == 7) {
-					nonSliderAttack(
-						row,
-						col,
-						1,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						6,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
+#pragma endregion
 
-				// row = 0 | col = 6
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						1,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
+#pragma region helper functions
 
-			// row = 0 | 1 < col < 6
-			else {
-				nonSliderAttack(
-					row,
-					col,
-					1,
-					col - 2,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					2,
-					col - 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					2,
-					col + 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					1,
-					col + 2,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
-		}
-		else {
-			if (col <= 1) {
-
-				// row = 1 | col = 0
-				if (col == 0) {
-					nonSliderAttack(
-						row,
-						col,
-						0,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						3,
-						1,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-
-				// row = 1 | col = 1
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						0,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						3,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						3,
-						0,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 1 | col = 7
-				if (col == 7) {
-					nonSliderAttack(
-						row,
-						col,
-						0,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					); nonSliderAttack(
-						row,
-						col,
-						3,
-						6,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-
-				// row = 1 | col = 6
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						0,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						2,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						3,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						3,
-						7,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-
-			// row = 1 | 1 < col < 6
-			else {
-				unsigned char downOne = row + 1;
-				unsigned char downTwo = row + 2;
-				unsigned char upOne = row - 1;
-				unsigned char rightTwo = col + 2;
-				unsigned char leftTwo = col - 2;
-				nonSliderAttack(
-					row,
-					col,
-					downOne,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					col - 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					col + 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downOne,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
+// sets the bitboards based on the board layout
+void Position::setBitboards() {
+	initTables();
+	for (unsigned char color = 0; color < 2; color++) {
+		colorBoards[color] = 0;
+		for (unsigned char type = 0; type < 6; type++) {
+			pieceBoards[color][type] = 0;
 		}
 	}
-	else if (row >= 6) {
-		if (row == 7) {
-			if (col <= 1) {
-
-				// row = 7 | col = 0
-				if (col == 0) {
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						1,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					); nonSliderAttack(
-						row,
-						col,
-						6,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
+	midgameScore = 0;
+	endgameScore = 0;
+	phase = 0;
+	pawnKey = 0;
 
-				// row = 7 | col = 1
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						0,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						6,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 7 | col = 7
-				if (col == 7) {
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						6,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						6,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-
-				// row = 7 | col = 6
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						7,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						6,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-
-			// row = 7 | 1 < col < 6
-			else {
-				unsigned char upOne = row - 1;
-				unsigned char upTwo = row - 2;
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					col - 2,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					col - 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					col + 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					col + 2,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
-		}
-		else {
-			if (col <= 1) {
-
-				// row = 6 | col = 0
-				if (col == 0) {
-					nonSliderAttack(
-						row,
-						col,
-						4,
-						1,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						7,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-
-				// row = 6 | col = 1
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						4,
-						0,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						4,
-						2,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						7,
-						3,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 6 | col = 7
-				if (col == 7) {
-					nonSliderAttack(
-						row,
-						col,
-						4,
-						6,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						7,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-
-				// row = 6 | col = 6
-				else {
-					nonSliderAttack(
-						row,
-						col,
-						7,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						4,
-						5,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						5,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-					nonSliderAttack(
-						row,
-						col,
-						7,
-						4,
-						check,
-						doubleCheck,
-						kingDangerSquares
-					);
-				}
-			}
-
-			// row = 6 | 1 < col < 6
-			else {
-				unsigned char upOne = row - 1;
-				unsigned char upTwo = row - 2;
-				unsigned char downOne = row + 1;
-				unsigned char rightTwo = col + 2;
-				unsigned char leftTwo = col - 2;
-				nonSliderAttack(
-					row,
-					col,
-					downOne,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					col - 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					col + 1,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upOne,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downOne,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
+	for (unsigned char square = 0; square < 64; square++) {
+		char piece = board[square / 8][square % 8];
+		if (piece != '-') {
+			Color color = isupper(piece) ? WHITE : BLACK;
+			PieceType type = pieceType(piece);
+			pieceBoards[color][type] |= squareBit(square);
+			colorBoards[color] |= squareBit(square);
+			midgameScore += PieceSquare::midgame[color][type][square];
+			endgameScore += PieceSquare::endgame[color][type][square];
+			phase += PieceSquare::phaseWeights[type];
+			if (type == PAWN) {
+				pawnKey ^= Zobrist::pieces[color][PAWN][square];
 			}
 		}
 	}
-	else {
-		if (col <= 1) {
-
-			// 1 < row < 6 | col = 0
-			if (col == 0) {
-				unsigned char rightOne = col + 1;
-				unsigned char rightTwo = col + 2;
-				nonSliderAttack(
-					row,
-					col,
-					row - 2,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row - 1,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 1,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 2,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
+	occupied = colorBoards[WHITE] | colorBoards[BLACK];
 
-			// 1 < row < 6 | col = 1
-			else {
-				unsigned char leftOne = col - 1;
-				unsigned char rightOne = col + 1;
-				unsigned char rightTwo = col + 2;
-				unsigned char upTwo = row - 2;
-				unsigned char downTwo = row + 2;
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row - 1,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 1,
-					rightTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
-		}
-		else if (col >= 6) {
-
-			// 1 < row < 6 | col = 7
-			if (col == 7) {
-				unsigned char leftOne = col - 1;
-				unsigned char leftTwo = col - 2;
-				nonSliderAttack(
-					row,
-					col,
-					row - 2,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row - 1,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 1,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 2,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
-
-			// 1 < row < 6 | col = 6
-			else {
-				unsigned char rightOne = col + 1;
-				unsigned char leftOne = col - 1;
-				unsigned char leftTwo = col - 2;
-				unsigned char upTwo = row - 2;
-				unsigned char downTwo = row + 2;
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					upTwo,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row - 1,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					row + 1,
-					leftTwo,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					leftOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-				nonSliderAttack(
-					row,
-					col,
-					downTwo,
-					rightOne,
-					check,
-					doubleCheck,
-					kingDangerSquares
-				);
-			}
-		}
-
-		// 1 < row < 6 | 1 < col < 6
-		else {
-			unsigned char rightOne = col + 1;
-			unsigned char rightTwo = col + 2;
-			unsigned char leftOne = col - 1;
-			unsigned char leftTwo = col - 2;
-			unsigned char upOne = row - 1;
-			unsigned char upTwo = row - 2;
-			unsigned char downOne = row + 1;
-			unsigned char downTwo = row + 2;
-			nonSliderAttack(
-				row,
-				col,
-				upTwo,
-				leftOne,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				upTwo,
-				rightOne,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				upOne,
-				rightTwo,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				downOne,
-				rightTwo,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				downTwo,
-				rightOne,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				downTwo,
-				leftOne,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				downOne,
-				leftTwo,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-			nonSliderAttack(
-				row,
-				col,
-				upOne,
-				leftTwo,
-				check,
-				doubleCheck,
-				kingDangerSquares
-			);
-		}
+	// makeMove only sets an en passant square that a pawn can capture on, so the same is done here to keep keys consistent
+	if (ep < 64 && !(Bitboards::pawnAttacks[whiteMove ? BLACK : WHITE][ep] & pieceBoards[whiteMove ? WHITE : BLACK][PAWN])) {
+		ep = 64;
 	}
+	key = computeKey();
 }
 
-// sets squares which are attacked by the enemy rooks
-void Position::rookAttack(
-	unsigned char row,
-	unsigned char col,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares,
-	unordered_set<unsigned char>* pinnedPieces
-) {
-	unsigned char pin = 64;
-	unsigned char bottomMax = 7 - row;
-	unsigned char rightMax = 7 - col;
-
-	// attack up
-	for (unsigned char top = 1; top <= row; top++) {
-		if (sliderAttack(
-			row,
-			col,
-			row - top,
-			col,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
+// returns the zobrist key of the position, computed from scratch
+unsigned long long Position::computeKey() {
+	unsigned long long out = Zobrist::castle[castle];
+	for (unsigned char color = 0; color < 2; color++) {
+		for (unsigned char type = 0; type < 6; type++) {
+			Bitboard pieces = pieceBoards[color][type];
+			while (pieces) {
+				out ^= Zobrist::pieces[color][type][popLsb(&pieces)];
+			}
 		}
 	}
-	pin = 64;
-
-	//attack down
-	for (unsigned char bottom = 1; bottom <= bottomMax; bottom++) {
-		if (sliderAttack(
-			row,
-			col,
-			row + bottom,
-			col,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
+	if (ep < 64) {
+		out ^= Zobrist::ep[ep % 8];
 	}
-	pin = 64;
-
-	//attack right
-	for (unsigned char right = 1; right <= rightMax; right++) {
-		if (sliderAttack(
-			row,
-			col,
-			row,
-			col + right,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
-	}
-	pin = 64;
-
-	// attack left
-	for (unsigned char left = 1; left <= col; left++) {
-		if (sliderAttack(
-			row,
-			col,
-			row,
-			col - left,
-			check,
-			doubleCheck,
-			kingDangerSquares,
-			&pin,
-			pinnedPieces
-		)) {
-			break;
-		}
+	if (!whiteMove) {
+		out ^= Zobrist::blackMove;
 	}
+	return out;
 }
 
-// sets squares which are attacked by the enemy pawns
-void Position::pawnAttack(
-	unsigned char row,
-	unsigned char col,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares
-) {
-	unsigned char rowAndDirection = row + (whiteMove ? 1 : -1);
-
-	// attack right
-	if (col <= 6) {
-		nonSliderAttack(
-			row,
-			col,
-			rowAndDirection,
-			col + 1,
-			check,
-			doubleCheck,
-			kingDangerSquares
-		);
-	}
-
-	// attack left
-	if (col >= 1) {
-		nonSliderAttack(
-			row,
-			col,
-			rowAndDirection,
-			col - 1,
-			check,
-			doubleCheck,
-			kingDangerSquares
-		);
-	}
+// returns the type of the piece represented by a char
+PieceType Position::pieceType(char piece) {
+	switch (tolower(piece)) {
+	case 'p':
+		return PAWN;
+	case 'n':
+		return KNIGHT;
+	case 'b':
+		return BISHOP;
+	case 'r':
+		return ROOK;
+	case 'q':
+		return QUEEN;
+	case 'k':
+		return KING;
+	}
+	return NO_PIECE_TYPE;
 }
 
-// sets squares which are attacked by enemy 'sliders' (queens, bishops, and rooks)
-// returns true when a piece should stop attacking in the current direction
-bool Position::sliderAttack(
-	unsigned char pieceRow,
-	unsigned char pieceCol,
-	unsigned char attackRow,
-	unsigned char attackCol,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares,
-	unsigned char* pin,
-	unordered_set<unsigned char>* pinnedPieces
+// places a piece on an empty square
+void Position::putPiece(
+	unsigned char square,
+	char piece
 ) {
-	char square = board[attackRow][attackCol];
-
-	// if the pin variable is set and the attacked square is the enemy king then the piece on the pin square is pinned
-	if (*pin < 64) {
-		if (square == (whiteMove ? 'K' : 'k')) {
-			pinnedPieces->insert(*pin);
-			return true;
-		}
-		else if (square != '-') {
-			return true;
-		}
-		return false;
+	Color color = isupper(piece) ? WHITE : BLACK;
+	Bitboard bit = squareBit(square);
+	PieceType type = pieceType(piece);
+	board[square / 8][square % 8] = piece;
+	pieceBoards[color][type] |= bit;
+	colorBoards[color] |= bit;
+	occupied |= bit;
+	key ^= Zobrist::pieces[color][type][square];
+	midgameScore += PieceSquare::midgame[color][type][square];
+	endgameScore += PieceSquare::endgame[color][type][square];
+	phase += PieceSquare::phaseWeights[type];
+	if (type == PAWN) {
+		pawnKey ^= Zobrist::pieces[color][PAWN][square];
 	}
+}
 
-	// if the attacked piece is an enemy then check for a pin
-	else {
-		if (square == '-') {
-			kingDangerSquares->insert(rowColToChar(attackRow, attackCol));
-			return false;
-		}
-		else if (square == (whiteMove ? 'K' : 'k')) {
-			if (*check < 64) {
-				*doubleCheck = true;
-			}
-			else {
-				*check = rowColToChar(pieceRow, pieceCol);
-				kingDangerSquares->insert(rowColToChar(attackRow, attackCol));
-			}
-			return false;
-		}
-		else {
-			if (whiteMove ? islower(square) : isupper(square)) {
-				kingDangerSquares->insert(rowColToChar(attackRow, attackCol));
-				return true;
-			}
-			else {
-				*pin = rowColToChar(attackRow, attackCol);
-				return false;
-			}
-		}
+// removes the piece on a square
+void Position::removePiece(unsigned char square) {
+	char piece = board[square / 8][square % 8];
+	Color color = isupper(piece) ? WHITE : BLACK;
+	Bitboard bit = squareBit(square);
+	PieceType type = pieceType(piece);
+	board[square / 8][square % 8] = '-';
+	pieceBoards[color][type] ^= bit;
+	colorBoards[color] ^= bit;
+	occupied ^= bit;
+	key ^= Zobrist::pieces[color][type][square];
+	midgameScore -= PieceSquare::midgame[color][type][square];
+	endgameScore -= PieceSquare::endgame[color][type][square];
+	phase -= PieceSquare::phaseWeights[type];
+	if (type == PAWN) {
+		pawnKey ^= Zobrist::pieces[color][PAWN][square];
 	}
 }
 
-// sets squares which are attacked by enemy 'non-sliders' (kings, knights, and pawns)
-void Position::nonSliderAttack(
-	unsigned char pieceRow,
-	unsigned char pieceCol,
-	unsigned char attackRow,
-	unsigned char attackCol,
-	unsigned char* check,
-	bool* doubleCheck,
-	unordered_set<unsigned char>* kingDangerSquares
+// moves a piece to an empty square
+void Position::movePiece(
+	unsigned char start,
+	unsigned char end
 ) {
-	if (board[attackRow][attackCol] == (whiteMove ? 'K' : 'k')) {
-		if (*check < 64) {
-			*doubleCheck = true;
-		}
-		else {
-			*check = rowColToChar(pieceRow, pieceCol);
-			kingDangerSquares->insert(rowColToChar(attackRow, attackCol));
-		}
-	}
-	else {
-		kingDangerSquares->insert(rowColToChar(attackRow, attackCol));
+	char piece = board[start / 8][start % 8];
+	Color color = isupper(piece) ? WHITE : BLACK;
+	Bitboard bits = squareBit(start) | squareBit(end);
+	PieceType type = pieceType(piece);
+	board[start / 8][start % 8] = '-';
+	board[end / 8][end % 8] = piece;
+	pieceBoards[color][type] ^= bits;
+	colorBoards[color] ^= bits;
+	occupied ^= bits;
+	key ^= Zobrist::pieces[color][type][start] ^ Zobrist::pieces[color][type][end];
+	midgameScore += PieceSquare::midgame[color][type][end] - PieceSquare::midgame[color][type][start];
+	endgameScore += PieceSquare::endgame[color][type][end] - PieceSquare::endgame[color][type][start];
+	if (type == PAWN) {
+		pawnKey ^= Zobrist::pieces[color][PAWN][start] ^ Zobrist::pieces[color][PAWN][end];
 	}
 }
 
-// generates a string that represents a move and adds it to the moves vector
-// returns false if a pinned piece cannot move to the given square
-bool Position::generateMove(
-	unsigned char startRow,
-	unsigned char startCol,
-	unsigned char endRow,
-	unsigned char endCol,
-	vector<string>* moves,
-	unordered_set<unsigned char>* pinnedPieces,
-	unsigned char kingRow,
-	unsigned char kingCol,
-	char promote,
-	bool ep
+// returns the squares attacked by the given color
+Bitboard Position::attackedSquares(
+	Color color,
+	Bitboard occupancy
 ) {
-	if (whiteMove ? isupper(board[endRow][endCol]) : islower(board[endRow][endCol])) {
-		return false;
-	}
+	Bitboard attacks =
+		Bitboards::pawnSetAttacks(color, pieceBoards[color][PAWN]) |
+		Bitboards::kingAttacks[lsb(pieceBoards[color][KING])];
 
-	// if a piece is pinned then it should only be able to move in a straight line towards or away from the king
-	if (pinnedPieces->count(rowColToChar(startRow, startCol))) {
-		if (board[startRow][startCol] == (whiteMove ? 'N' : 'n') || !onLine(
-			kingRow,
-			kingCol,
-			startRow,
-			startCol,
-			endRow,
-			endCol
-		)) {
-			return false;
-		}
+	Bitboard pieces = pieceBoards[color][KNIGHT];
+	while (pieces) {
+		attacks |= Bitboards::knightAttacks[popLsb(&pieces)];
 	}
 
-	string move = "";
-	move += rowColToChar(startRow, startCol);
-	move += rowColToChar(endRow, endCol);
-
-	if (promote != '-') {
-		move += promote;
-	}
-	else if (ep) {
-		move += 'e';
+	pieces = pieceBoards[color][BISHOP] | pieceBoards[color][QUEEN];
+	while (pieces) {
+		attacks |= Bitboards::bishopAttacks(popLsb(&pieces), occupancy);
 	}
-	moves->push_back(move);
-	return true;
-}
 
-// generates a string that represents a move and adds it to the moves vector
-// returns false if the move is not valid
-bool Position::generateKingMove(
-	unsigned char startRow,
-	unsigned char startCol,
-	unsigned char endRow,
-	unsigned char endCol,
-	vector<string>* moves,
-	unordered_set<unsigned char>* kingDangerSquares
-) {
-	if (
-		kingDangerSquares->count(rowColToChar(endRow, endCol)) ||
-		(whiteMove ? isupper(board[endRow][endCol]) : islower(board[endRow][endCol]))
-	) {
-		return false;
+	pieces = pieceBoards[color][ROOK] | pieceBoards[color][QUEEN];
+	while (pieces) {
+		attacks |= Bitboards::rookAttacks(popLsb(&pieces), occupancy);
 	}
 
-	string move = "";
-	move += rowColToChar(startRow, startCol);
-	move += rowColToChar(endRow, endCol);
-
-	moves->push_back(move);
-	return true;
+	return attacks;
 }
 
-// generates moves for king
-void Position::generateKingMoves(
-	unsigned char row,
-	unsigned char col,
-	vector<string>* moves,
-	unordered_set<unsigned char>* kingDangerSquares
-) {
-	if (row == 0) {
-		unsigned char rowBottom = row + 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-	}
-	else if (row == 7) {
-		unsigned char rowTop = row - 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-	}
-	else {
-		unsigned char rowTop = row - 1;
-		unsigned char rowBottom = row + 1;
-		if (col == 0) {
-			unsigned char colRight = col + 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else if (col == 7) {
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-		else {
-			unsigned char colRight = col + 1;
-			unsigned char colLeft = col - 1;
-			generateKingMove(
-				row,
-				col,
-				row,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				row,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowTop,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				col,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colRight,
-				moves,
-				kingDangerSquares
-			);
-			generateKingMove(
-				row,
-				col,
-				rowBottom,
-				colLeft,
-				moves,
-				kingDangerSquares
-			);
-		}
-	}
-}
+// returns the pieces of the given color that are pinned to their own king
+Bitboard Position::pinnedPieces(Color color) {
+	Color enemy = color == WHITE ? BLACK : WHITE;
+	unsigned char kingSquare = lsb(pieceBoards[color][KING]);
+	Bitboard pinned = 0;
 
-// generates moves for bishops
-void Position::generateBishopMoves(
-	unsigned char row,
-	unsigned char col,
-	vector<string>* pseudoLegalMoves,
-	unordered_set<unsigned char>* pinnedPieces,
-	unsigned char kingRow,
-	unsigned char kingCol
-) {
-	unsigned char topLeftMax = min(row, col);
-	unsigned char topRightMax = min(row, unsigned char(7 - col));
-	unsigned char bottomRightMax = min(unsigned char(7 - row), unsigned char(7 - col));
-	unsigned char bottomLeftMax = min(unsigned char(7 - row), col);
-
-	// search squares up and left
-	for (unsigned char topLeft = 1; topLeft <= topLeftMax; topLeft++) {
-		unsigned char rowIndex = row - topLeft;
-		unsigned char colIndex = col - topLeft;
-		char square = board[rowIndex][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
-		}
-	}
-
-	// search squares up and right
-	for (unsigned char topRight = 1; topRight <= topRightMax; topRight++) {
-		unsigned char rowIndex = row - topRight;
-		unsigned char colIndex = col + topRight;
-		char square = board[rowIndex][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
-		}
-	}
-
-	// search squares down and left
-	for (unsigned char bottomLeft = 1; bottomLeft <= bottomLeftMax; bottomLeft++) {
-		unsigned char rowIndex = row + bottomLeft;
-		unsigned char colIndex = col - bottomLeft;
-		char square = board[rowIndex][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
-		}
-	}
+	// enemy sliders that would attack the king on an empty board
+	Bitboard snipers =
+		(Bitboards::bishopAttacks(kingSquare, 0) & (pieceBoards[enemy][BISHOP] | pieceBoards[enemy][QUEEN])) |
+		(Bitboards::rookAttacks(kingSquare, 0) & (pieceBoards[enemy][ROOK] | pieceBoards[enemy][QUEEN]));
 
-	//search squares down and right
-	for (unsigned char bottomRight = 1; bottomRight <= bottomRightMax; bottomRight++) {
-		unsigned char rowIndex = row + bottomRight;
-		unsigned char colIndex = col + bottomRight;
-		char square = board[rowIndex][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
+	while (snipers) {
+		Bitboard blockers = Bitboards::between[kingSquare][popLsb(&snipers)] & occupied;
+		if (blockers && !moreThanOne(blockers)) {
+			pinned |= blockers & colorBoards[color];
 		}
 	}
+	return pinned;
 }
 
-// generates moves for knights
-void Position::generateKnightMoves(
-	unsigned char row,
-	unsigned char col,
-	vector<string>* pseudoLegalMoves,
-	unordered_set<unsigned char>* pinnedPieces,
-	unsigned char kingRow,
-	unsigned char kingCol
+// returns the squares a piece may move to without leaving its king's line | every square if it is not pinned
+Bitboard Position::pinRay(
+	unsigned char square,
+	Bitboard pinned,
+	unsigned char kingSquare
 ) {
-	if (row <= 1) {
-		if (row == 0) {
-			if (col <= 1) {
-
-				// row = 0 | col = 0
-				if (col == 0) {
-					generateMove(
-						row,
-						col,
-						2,
-						1,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						1,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-
-				// row = 0 | col = 1
-				else {
-					generateMove(
-						row,
-						col,
-						2,
-						0,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						1,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 0 | col = 7
-				if (col == 7) {
-					generateMove(
-						row,
-						col,
-						1,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						6,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-
-				// row = 0 | col = 6
-				else {
-					generateMove(
-						row,
-						col,
-						1,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
-
-			// row = 0 | 1 < col < 6
-			else {
-				generateMove(
-					row,
-					col,
-					1,
-					col - 2,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					2,
-					col - 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					2,
-					col + 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					1,
-					col + 2,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
-		else {
-			if (col <= 1) {
-
-				// row = 1 | col = 0
-				if (col == 0) {
-					generateMove(
-						row,
-						col,
-						0,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						3,
-						1,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
+	return (pinned & squareBit(square)) ? Bitboards::line[kingSquare][square] : ~0ULL;
+}
 
-				// row = 1 | col = 1
-				else {
-					generateMove(
-						row,
-						col,
-						0,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						3,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						3,
-						0,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 1 | col = 7
-				if (col == 7) {
-					generateMove(
-						row,
-						col,
-						0,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					); generateMove(
-						row,
-						col,
-						3,
-						6,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
+// fills moves with the legal moves of the given kind made by the pieces on the given squares
+void Position::generateLegal(
+	MoveList* moves,
+	GenType type,
+	const LegalityMasks& masks,
+	Bitboard pieceSquares
+) {
+	Color us = whiteMove ? WHITE : BLACK;
+	Color them = whiteMove ? BLACK : WHITE;
+	unsigned char kingSquare = masks.kingSquare;
+	Bitboard kingDangerSquares = masks.kingDangerSquares;
+	Bitboard checkers = masks.checkers;
+	Bitboard pinned = masks.pinned;
+	Bitboard checkMask = masks.checkMask;
+	moves->clear();
+
+#pragma region generate masks
+
+	// squares the wanted kind of move may end on, before checks are taken into account
+	Bitboard kinds = type == CAPTURES ? colorBoards[them] : type == QUIETS ? ~occupied : ~colorBoards[us];
+	Bitboard targets = kinds & checkMask;
+
+	// pushes onto the last row are promotions, so they belong with the captures
+	Bitboard lastRow = whiteMove ? ROW_8 : ROW_1;
+	Bitboard pawnTargets =
+		type == CAPTURES ? targets | (checkMask & ~occupied & lastRow) :
+		type == QUIETS ? targets & ~lastRow :
+		targets;
 
-				// row = 1 | col = 6
-				else {
-					generateMove(
-						row,
-						col,
-						0,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						2,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						3,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						3,
-						7,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
+#pragma endregion
 
-			// row = 1 | 1 < col < 6
-			else {
-				unsigned char downOne = row + 1;
-				unsigned char downTwo = row + 2;
-				unsigned char upOne = row - 1;
-				unsigned char rightTwo = col + 2;
-				unsigned char leftTwo = col - 2;
-				generateMove(
-					row,
-					col,
-					downOne,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					col - 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					col + 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downOne,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upOne,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upOne,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
+	if (pieceSquares & squareBit(kingSquare)) {
+		generateMoves(
+			kingSquare,
+			Bitboards::kingAttacks[kingSquare] & kinds & ~kingDangerSquares,
+			moves
+		);
 	}
-	else if (row >= 6) {
-		if (row == 7) {
-			if (col <= 1) {
-
-				// row = 7 | col = 0
-				if (col == 0) {
-					generateMove(
-						row,
-						col,
-						5,
-						1,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					); generateMove(
-						row,
-						col,
-						6,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
 
-				// row = 7 | col = 1
-				else {
-					generateMove(
-						row,
-						col,
-						5,
-						0,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						6,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 7 | col = 7
-				if (col == 7) {
-					generateMove(
-						row,
-						col,
-						5,
-						6,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						6,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
+	// only the king can move out of double check
+	if (moreThanOne(checkers)) {
+		return;
+	}
 
-				// row = 7 | col = 6
-				else {
-					generateMove(
-						row,
-						col,
-						5,
-						7,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						6,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
+#pragma region generate piece moves
 
-			// row = 7 | 1 < col < 6
-			else {
-			unsigned char upOne = row - 1;
-			unsigned char upTwo = row - 2;
-				generateMove(
-					row,
-					col,
-					upOne,
-					col - 2,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					col - 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					col + 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upOne,
-					col + 2,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
-		else {
-			if (col <= 1) {
-
-				// row = 6 | col = 0
-				if (col == 0) {
-					generateMove(
-						row,
-						col,
-						4,
-						1,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						7,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
+	// a pinned knight can never stay on its pin line
+	Bitboard pieces = pieceBoards[us][KNIGHT] & ~pinned & pieceSquares;
+	while (pieces) {
+		unsigned char square = popLsb(&pieces);
+		generateMoves(
+			square,
+			Bitboards::knightAttacks[square] & targets,
+			moves
+		);
+	}
 
-				// row = 6 | col = 1
-				else {
-					generateMove(
-						row,
-						col,
-						4,
-						0,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						4,
-						2,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						7,
-						3,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
-			else if (col >= 6) {
-
-				// row = 6 | col = 7
-				if (col == 7) {
-					generateMove(
-						row,
-						col,
-						4,
-						6,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						7,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
+	pieces = (pieceBoards[us][BISHOP] | pieceBoards[us][QUEEN]) & pieceSquares;
+	while (pieces) {
+		unsigned char square = popLsb(&pieces);
+		generateMoves(
+			square,
+			Bitboards::bishopAttacks(square, occupied) & targets & pinRay(square, pinned, kingSquare),
+			moves
+		);
+	}
 
-				// row = 6 | col = 6
-				else {
-					generateMove(
-						row,
-						col,
-						7,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						4,
-						5,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						5,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-					generateMove(
-						row,
-						col,
-						7,
-						4,
-						pseudoLegalMoves,
-						pinnedPieces,
-						kingRow,
-						kingCol
-					);
-				}
-			}
+	pieces = (pieceBoards[us][ROOK] | pieceBoards[us][QUEEN]) & pieceSquares;
+	while (pieces) {
+		unsigned char square = popLsb(&pieces);
+		generateMoves(
+			square,
+			Bitboards::rookAttacks(square, occupied) & targets & pinRay(square, pinned, kingSquare),
+			moves
+		);
+	}
 
-			// row = 6 | 1 < col < 6
-			else {
-			unsigned char upOne = row - 1;
-			unsigned char upTwo = row - 2;
-			unsigned char downOne = row + 1;
-			unsigned char rightTwo = col + 2;
-			unsigned char leftTwo = col - 2;
-				generateMove(
-					row,
-					col,
-					downOne,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upOne,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					col - 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					col + 1,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upOne,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downOne,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
+	pieces = pieceBoards[us][PAWN] & pieceSquares;
+	while (pieces) {
+		unsigned char square = popLsb(&pieces);
+		generatePawnMoves(
+			square,
+			pawnTargets & pinRay(square, pinned, kingSquare),
+			moves
+		);
 	}
-	else {
-		if (col <= 1) {
-
-			// 1 < row < 6 | col = 0
-			if (col == 0) {
-				unsigned char rightOne = col + 1;
-				unsigned char rightTwo = col + 2;
-				generateMove(
-					row,
-					col,
-					row - 2,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row - 1,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 1,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 2,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
 
-			// 1 < row < 6 | col = 1
-			else {
-				unsigned char leftOne = col - 1;
-				unsigned char rightOne = col + 1;
-				unsigned char rightTwo = col + 2;
-				unsigned char upTwo = row - 2;
-				unsigned char downTwo = row + 2;
-				generateMove(
-					row,
-					col,
-					upTwo,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row - 1,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 1,
-					rightTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
-		else if (col >= 6) {
-
-			// 1 < row < 6 | col = 7
-			if (col == 7) {
-				unsigned char leftOne = col - 1;
-				unsigned char leftTwo = col - 2;
-				generateMove(
-					row,
-					col,
-					row - 2,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row - 1,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 1,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 2,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
+	if (type != QUIETS) {
+		generateEnPassant(
+			kingSquare,
+			checkMask,
+			pieceSquares,
+			moves
+		);
+	}
 
-			// 1 < row < 6 | col = 6
-			else {
-				unsigned char rightOne = col + 1;
-				unsigned char leftOne = col - 1;
-				unsigned char leftTwo = col - 2;
-				unsigned char upTwo = row - 2;
-				unsigned char downTwo = row + 2;
-				generateMove(
-					row,
-					col,
-					upTwo,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					upTwo,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row - 1,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					row + 1,
-					leftTwo,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					leftOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-				generateMove(
-					row,
-					col,
-					downTwo,
-					rightOne,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol
-				);
-			}
-		}
+#pragma endregion
 
-		// 1 < row < 6 | 1 < col < 6
-		else {
-			unsigned char rightOne = col + 1;
-			unsigned char rightTwo = col + 2;
-			unsigned char leftOne = col - 1;
-			unsigned char leftTwo = col - 2;
-			unsigned char upOne = row - 1;
-			unsigned char upTwo = row - 2;
-			unsigned char downOne = row + 1;
-			unsigned char downTwo = row + 2;
-			generateMove(
-				row,
-				col,
-				upTwo,
-				leftOne,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				upTwo,
-				rightOne,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				upOne,
-				rightTwo,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				downOne,
-				rightTwo,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				downTwo,
-				rightOne,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				downTwo,
-				leftOne,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				downOne,
-				leftTwo,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-			generateMove(
-				row,
-				col,
-				upOne,
-				leftTwo,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-		}
+	if (!checkers && type != CAPTURES && (pieceSquares & squareBit(kingSquare))) {
+		generateCastles(
+			kingSquare,
+			kingDangerSquares,
+			moves
+		);
 	}
 }
 
-// generates moves for rooks
-void Position::generateRookMoves(
-	unsigned char row,
-	unsigned char col,
-	vector<string>* pseudoLegalMoves,
-	unordered_set<unsigned char>* pinnedPieces,
-	unsigned char kingRow,
-	unsigned char kingCol
+// generates a move for each target square
+void Position::generateMoves(
+	unsigned char square,
+	Bitboard targets,
+	MoveList* moves
 ) {
-	unsigned char bottomMax = 7 - row;
-	unsigned char rightMax = 7 - col;
-
-	// search squares above
-	for (unsigned char top = 1; top <= row; top++) {
-		unsigned char rowIndex = row - top;
-		char square = board[rowIndex][col];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			col,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
-		}
+	while (targets) {
+		moves->add(Move(square, popLsb(&targets)));
 	}
+}
 
-	// search squares below
-	for (unsigned char bottom = 1; bottom <= bottomMax; bottom++) {
-		unsigned char rowIndex = row + bottom;
-		char square = board[rowIndex][col];
-		if (!generateMove(
-			row,
-			col,
-			rowIndex,
-			col,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
-		}
-	}
+// generates moves for a pawn, limited to the target squares
+void Position::generatePawnMoves(
+	unsigned char square,
+	Bitboard targets,
+	MoveList* moves
+) {
+	Color us = whiteMove ? WHITE : BLACK;
+	Color them = whiteMove ? BLACK : WHITE;
+	unsigned char front = whiteMove ? square - 8 : square + 8;
+	Bitboard ends = Bitboards::pawnAttacks[us][square] & colorBoards[them];
 
-	// search squares to the right
-	for (unsigned char right = 1; right <= rightMax; right++) {
-		unsigned char colIndex = col + right;
-		char square = board[row][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			row,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
+	// normal forward move
+	if (!(occupied & squareBit(front))) {
+		ends |= squareBit(front);
+
+		// move 2 squares on first move
+		unsigned char doubleFront = whiteMove ? front - 8 : front + 8;
+		if (square / 8 == (whiteMove ? 6 : 1) && !(occupied & squareBit(doubleFront))) {
+			ends |= squareBit(doubleFront);
 		}
 	}
+	ends &= targets;
 
-	// search squares to the left
-	for (unsigned char left = 1; left <= col; left++) {
-		unsigned char colIndex = col - left;
-		char square = board[row][colIndex];
-		if (!generateMove(
-			row,
-			col,
-			row,
-			colIndex,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		)) {
-			break;
-		}
-		if (square != '-') {
-			break;
+	// promotion
+	if (square / 8 == (whiteMove ? 1 : 6)) {
+		while (ends) {
+			unsigned char end = popLsb(&ends);
+			moves->add(Move(square, end, PROMOTION, QUEEN));
+			moves->add(Move(square, end, PROMOTION, KNIGHT));
+			moves->add(Move(square, end, PROMOTION, ROOK));
+			moves->add(Move(square, end, PROMOTION, BISHOP));
 		}
+		return;
 	}
+
+	generateMoves(
+		square,
+		ends,
+		moves
+	);
 }
 
-// generates moves for pawns
-void Position::generatePawnMoves(
-	unsigned char row,
-	unsigned char col,
-	vector<string>* pseudoLegalMoves,
-	unordered_set<unsigned char>* pinnedPieces,
-	unsigned char kingRow,
-	unsigned char kingCol
+// generates en passant captures by the pawns on the given squares
+void Position::generateEnPassant(
+	unsigned char kingSquare,
+	Bitboard checkMask,
+	Bitboard pieceSquares,
+	MoveList* moves
 ) {
-	signed char direction = whiteMove ? -1 : 1;
-	unsigned char rowAndDirection = row + direction;
-	unsigned char rightCol = col + 1;
-	unsigned char leftCol = col - 1;
-	unsigned char frontSquare = board[rowAndDirection][col];
-
-	// capture right
-	if (
-		col <= 6 &&
-		(whiteMove ? islower(board[rowAndDirection][rightCol]) : isupper(board[rowAndDirection][rightCol]))
-	) {
-		// promotion
-		if (row == (whiteMove ? 1 : 6)) {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				rightCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'Q' : 'q'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				rightCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'B' : 'b'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				rightCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'N' : 'n'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				rightCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'R' : 'r'
-			);
-		}
-		else {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				rightCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-		}
+	if (ep == 64) {
+		return;
 	}
 
-	// capture left
-	if (
-		col >= 1 &&
-		(whiteMove ? islower(board[rowAndDirection][leftCol]) : isupper(board[rowAndDirection][leftCol]))
-	) {
-
-		// promotion
-		if (row == (whiteMove ? 1 : 6)) {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				leftCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'Q' : 'q'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				leftCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'B' : 'b'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				leftCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'N' : 'n'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				leftCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'R' : 'r'
-			);
-		}
-		else {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				leftCol,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-		}
-	}
+	Color us = whiteMove ? WHITE : BLACK;
+	Color them = whiteMove ? BLACK : WHITE;
+	unsigned char epSquare = ep;
+	unsigned char captured = whiteMove ? epSquare + 8 : epSquare - 8;
 
-	// normal forward move
-	if (frontSquare == '-') {
-
-		// promotion
-		if (row == (whiteMove ? 1 : 6)) {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				col,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'Q' : 'q'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				col,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'B' : 'b'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				col,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'N' : 'n'
-			);
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				col,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol,
-				whiteMove ? 'R' : 'r'
-			);
-		}
-		else {
-			generateMove(
-				row,
-				col,
-				rowAndDirection,
-				col,
-				pseudoLegalMoves,
-				pinnedPieces,
-				kingRow,
-				kingCol
-			);
-		}
+	// the capture has to remove the checker or block the check
+	if (!(checkMask & (squareBit(epSquare) | squareBit(captured)))) {
+		return;
 	}
 
-	// move 2 squares on first move
-	if (
-		row == (whiteMove ? 6 : 1) &&
-		frontSquare == '-' &&
-		board[rowAndDirection + direction][col] == '-'
-	) {
-		generateMove(
-			row,
-			col,
-			rowAndDirection + direction,
-			col,
-			pseudoLegalMoves,
-			pinnedPieces,
-			kingRow,
-			kingCol
-		);
-	}
+	Bitboard pawns = Bitboards::pawnAttacks[them][epSquare] & pieceBoards[us][PAWN] & pieceSquares;
+	while (pawns) {
+		unsigned char square = popLsb(&pawns);
 
-	// en passant
-	if (ep != "-") {
-		unsigned char epCol = ep.at(0) - 97;
-		if (rowAndDirection == 56 - ep.at(1)) {
-			if (rightCol == epCol) {
-				generateMove(
-					row,
-					col,
-					rowAndDirection,
-					rightCol,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol,
-					'-',
-					true
-				);
-			}
-			else if (leftCol == epCol) {
-				generateMove(
-					row,
-					col,
-					rowAndDirection,
-					leftCol,
-					pseudoLegalMoves,
-					pinnedPieces,
-					kingRow,
-					kingCol,
-					'-',
-					true
-				);
-			}
+		// two pawns leave the same row at once, so pins are checked against the board after the capture
+		Bitboard after = (occupied ^ squareBit(square) ^ squareBit(captured)) | squareBit(epSquare);
+		if (
+			!(Bitboards::bishopAttacks(kingSquare, after) & (pieceBoards[them][BISHOP] | pieceBoards[them][QUEEN])) &&
+			!(Bitboards::rookAttacks(kingSquare, after) & (pieceBoards[them][ROOK] | pieceBoards[them][QUEEN]))
+		) {
+			moves->add(Move(square, epSquare, EN_PASSANT));
 		}
 	}
 }
 
-// returns true if all 3 points are on the same line
-bool Position::onLine(
-	unsigned char anchorRow,
-	unsigned char anchorCol,
-	unsigned char pointOneRow,
-	unsigned char pointOneCol,
-	unsigned char pointTwoRow,
-	unsigned char pointTwoCol
-) {
-	signed char startRowDist = pointOneRow - anchorRow;
-	signed char startColDist = pointOneCol - anchorCol;
-	signed char endRowDist = pointTwoRow - anchorRow;
-	signed char endColDist = pointTwoCol - anchorCol;
-
-	return min(startRowDist, startColDist) / double(max(startRowDist, startColDist)) == min(endRowDist, endColDist) / double(max(endRowDist, endColDist));
-}
-
-// returns true if the number is strictly between lower and upper
-bool Position::isBetween(
-	unsigned char number,
-	unsigned char lower,
-	unsigned char upper
+// generates castle moves
+void Position::generateCastles(
+	unsigned char kingSquare,
+	Bitboard kingDangerSquares,
+	MoveList* moves
 ) {
-	return (number < upper && number > lower);
+	if (castle & (whiteMove ? WHITE_SHORT : BLACK_SHORT)) {
+		Bitboard path = squareBit(kingSquare + 1) | squareBit(kingSquare + 2);
+		if (!(kingDangerSquares & path) && !(occupied & path)) {
+			moves->add(Move(kingSquare, kingSquare + 2, CASTLING));
+		}
+	}
+	if (castle & (whiteMove ? WHITE_LONG : BLACK_LONG)) {
+		Bitboard path = squareBit(kingSquare - 1) | squareBit(kingSquare - 2);
+		if (!(kingDangerSquares & path) && !(occupied & (path | squareBit(kingSquare - 3)))) {
+			moves->add(Move(kingSquare, kingSquare - 2, CASTLING));
+		}
+	}
 }
 
 // returns a char representing a square on the board
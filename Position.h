@@ -2,10 +2,49 @@
 
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include "Bitboard.h"
+#include "MoveList.h"
+#include "Zobrist.h"
+#include "PieceSquare.h"
 
 using namespace std;
 
+enum CastleRight : unsigned char {
+	WHITE_SHORT = 1,
+	WHITE_LONG = 2,
+	BLACK_SHORT = 4,
+	BLACK_LONG = 8
+};
+
+// material value of each piece type in centipawns | the king is never traded, so it is worth nothing
+const int pieceValues[6] = { 100, 320, 330, 500, 900, 0 };
+
+// which legal moves a generator produces
+enum GenType : unsigned char {
+	ALL_MOVES,
+	CAPTURES,		// captures, including en passant, and promotions
+	QUIETS			// every other move, including castles
+};
+
+// the parts of a position that makeMove cannot work out again when undoing a move
+struct Undo {
+	char captured;					// piece removed by the move | is '-' if nothing was captured
+	unsigned char castle;			// castle rights before the move
+	unsigned char ep;				// en passant square before the move
+	unsigned char fiftyMoveRule;	// fifty move rule counter before the move
+	unsigned long long key;			// zobrist key before the move
+};
+
+// the attack and pin information the legal move generators need, which depends only on the position
+// a caller that generates moves from the same position several times, like MovePicker, works it out once and passes it to each generator
+struct LegalityMasks {
+	unsigned char kingSquare;		// square of the side to move's king
+	Bitboard kingDangerSquares;		// squares the king may not move to | the attacks pass through the king
+	Bitboard checkers;				// pieces giving check
+	Bitboard pinned;				// pieces of the side to move pinned to their king
+	Bitboard checkMask;				// squares that block or capture the checker | every square when not in check
+};
+
 class Position {
 public:
 
@@ -22,10 +61,18 @@ public:
 		{'-', '-', '-', '-', '-', '-', '-', '-'}
 	};
 	bool whiteMove = true;				// true if it is white's turn
-	string castle = "-";				// available castle moves
-	string ep = "-";					// en passant square | is "-" if no en passant
+	unsigned char castle = 0;			// available castle moves as CastleRight flags
+	unsigned char ep = 64;				// en passant square | is 64 if no en passant
 	unsigned char fiftyMoveRule = 0;	// counting the number of moves without a pawn move or a capture
 	unsigned short int moveCount = 1;	// move number
+	Bitboard pieceBoards[2][6] = {};	// squares occupied by each piece type of each color
+	Bitboard colorBoards[2] = {};		// squares occupied by each color
+	Bitboard occupied = 0;				// squares occupied by any piece
+	unsigned long long key = 0;			// zobrist key of the position
+	unsigned long long pawnKey = 0;		// zobrist key of the pawns alone | the key of the pawn table
+	int midgameScore = 0;				// sum of the middlegame piece square values of every piece, from white's point of view
+	int endgameScore = 0;				// sum of the endgame piece square values of every piece, from white's point of view
+	unsigned char phase = 0;			// sum of the phase weights of every piece | see PieceSquare::MAX_PHASE
 
 #pragma endregion
 
@@ -47,20 +94,99 @@ public:
 	// returns a Position with the starting position
 	static Position StartingPosition();
 
+	// fills the attack, zobrist and piece square tables, in that order | only the first call does anything
+	// every position that is set up calls this, so the tables are ready before any position uses them
+	static void initTables();
+
 	// generates an FEN based on the board position
 	string FEN();
 
 	// creates a board position based on the FEN
 	void setToFEN(string FEN);
 
-	// returns a list of legal moves
-	vector<string> legalMoves();
+	// fills moves with the legal moves
+	void legalMoves(MoveList* moves);
+
+	// fills moves with the legal captures and promotions | quiet moves are never generated, so this is much cheaper than legalMoves
+	void legalCaptures(MoveList* moves);
+
+	// fills moves with the legal captures and promotions, using masks already worked out for this position
+	void legalCaptures(
+		MoveList* moves,
+		const LegalityMasks& masks
+	);
+
+	// fills moves with the legal moves that are not captures or promotions
+	void legalQuiets(MoveList* moves);
+
+	// fills moves with the legal moves that are not captures or promotions, using masks already worked out for this position
+	void legalQuiets(
+		MoveList* moves,
+		const LegalityMasks& masks
+	);
+
+	// returns true if the move is legal in this position
+	// used for moves that come from somewhere other than the generator, like the transposition table
+	bool isLegal(Move move);
+
+	// returns true if the move is legal in this position, using masks already worked out for it
+	bool isLegal(
+		Move move,
+		const LegalityMasks& masks
+	);
+
+	// fills masks with the attack and pin information of this position
+	void legalityMasks(LegalityMasks* masks);
+
+	// returns true if the move captures a piece or promotes a pawn
+	bool isCapture(Move move);
+
+	// returns the type of the piece on a square | NO_PIECE_TYPE if it is empty
+	PieceType pieceOn(unsigned char square);
+
+	// returns the pieces of both colors that attack the square
+	// pieces missing from occupancy are treated as gone, so sliders behind them are found as well
+	Bitboard attackersTo(
+		unsigned char square,
+		Bitboard occupancy
+	);
+
+	// returns the material the side to move wins in centipawns if both sides keep capturing on the move's end square, each with its least valuable piece
+	// either side may stop capturing when it would lose material | pins are ignored
+	int see(Move move);
+
+	// returns true if the side to move is in check
+	bool inCheck();
+
+	// plays a legal move and returns what is needed to undo it
+	Undo makeMove(Move move);
+
+	// takes back a move played by makeMove
+	void unmakeMove(
+		Move move,
+		const Undo& undo
+	);
+
+	// passes the turn to the other side without moving and returns what is needed to undo it | must not be called when in check
+	Undo makeNullMove();
+
+	// takes back a turn passed by makeNullMove
+	void unmakeNullMove(const Undo& undo);
+
+	// returns true if the color has a knight, bishop, rook or queen
+	bool hasPieces(Color color);
 	
 	// prints the board to the console
 	void printBoard();
 
 	// returns a string representing a move that is more readable for humans
-	static string translateMove(string move);
+	static string translateMove(Move move);
+
+	// returns a move in the notation used by UCI, for example "e2e4" or "e7e8q"
+	static string uciMove(Move move);
+
+	// returns the name of a square, for example "e4"
+	static string squareName(unsigned char square);
 
 #pragma endregion
 
@@ -68,165 +194,81 @@ private:
 
 #pragma region helper functions
 
-	// sets squares which are attacked by the enemy king
-	void kingAttack(
-		unsigned char row,
-		unsigned char col,
-		unordered_set<unsigned char>* kingDangerSquares
-	);
+	// sets the bitboards based on the board layout
+	void setBitboards();
 
-	// sets squares which are attacked by the enemy bishops
-	void bishopAttack(
-		unsigned char row,
-		unsigned char col,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares,
-		unordered_set<unsigned char>* pinnedPieces
-	);
+	// returns the zobrist key of the position, computed from scratch
+	unsigned long long computeKey();
 
-	// sets squares which are attacked by the enemy knights
-	void knightAttack(
-		unsigned char row,
-		unsigned char col,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares
-	);
-
-	// sets squares which are attacked by the enemy rooks
-	void rookAttack(
-		unsigned char row,
-		unsigned char col,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares,
-		unordered_set<unsigned char>* pinnedPieces
-	);
-	
-	// sets squares which are attacked by the enemy pawns
-	void pawnAttack(
-		unsigned char row,
-		unsigned char col,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares
-	);
+	// returns the type of the piece represented by a char
+	static PieceType pieceType(char piece);
 
-	// sets squares which are attacked by enemy 'sliders' (queens, bishops, and rooks)
-	// returns true when a piece should stop attacking in the current direction
-	bool sliderAttack(
-		unsigned char pieceRow,
-		unsigned char pieceCol,
-		unsigned char attackRow,
-		unsigned char attackCol,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares,
-		unsigned char* pin,
-		unordered_set<unsigned char>* pinnedPieces
+	// places a piece on an empty square
+	void putPiece(
+		unsigned char square,
+		char piece
 	);
 
-	// sets squares which are attacked by enemy 'non-sliders' (kings, knights, and pawns)
-	void nonSliderAttack(
-		unsigned char pieceRow,
-		unsigned char pieceCol,
-		unsigned char attackRow,
-		unsigned char attackCol,
-		unsigned char* check,
-		bool* doubleCheck,
-		unordered_set<unsigned char>* kingDangerSquares
-	);
+	// removes the piece on a square
+	void removePiece(unsigned char square);
 
-	// generates a string that represents a move and adds it to the moves vector
-	// returns false if a pinned piece cannot move to the given square
-	bool generateMove(
-		unsigned char startRow,
-		unsigned char startCol,
-		unsigned char endRow,
-		unsigned char endCol,
-		vector<string>* moves,
-		unordered_set<unsigned char>* pinnedPieces,
-		unsigned char kingRow,
-		unsigned char kingCol,
-		char promote = '-',
-		bool ep = false
+	// moves a piece to an empty square
+	void movePiece(
+		unsigned char start,
+		unsigned char end
 	);
 
-	// generates a string that represents a move and adds it to the moves vector
-	// returns false if the move is not valid
-	bool generateKingMove(
-		unsigned char startRow,
-		unsigned char startCol,
-		unsigned char endRow,
-		unsigned char endCol,
-		vector<string>* moves,
-		unordered_set<unsigned char>* kingDangerSquares
+	// returns the squares attacked by the given color
+	Bitboard attackedSquares(
+		Color color,
+		Bitboard occupancy
 	);
 
-	// generates moves for king
-	void generateKingMoves(
-		unsigned char row,
-		unsigned char col,
-		vector<string>* moves,
-		unordered_set<unsigned char>* kingDangerSquares
-	);
+	// returns the pieces of the given color that are pinned to their own king
+	Bitboard pinnedPieces(Color color);
 
-	// generates moves for bishops
-	void generateBishopMoves(
-		unsigned char row,
-		unsigned char col,
-		vector<string>* pseudoLegalMoves,
-		unordered_set<unsigned char>* pinnedPieces,
-		unsigned char kingRow,
-		unsigned char kingCol
+	// returns the squares a piece may move to without leaving its king's line | every square if it is not pinned
+	Bitboard pinRay(
+		unsigned char square,
+		Bitboard pinned,
+		unsigned char kingSquare
 	);
 
-	// generates moves for knights
-	void generateKnightMoves(
-		unsigned char row,
-		unsigned char col,
-		vector<string>* pseudoLegalMoves,
-		unordered_set<unsigned char>* pinnedPieces,
-		unsigned char kingRow,
-		unsigned char kingCol
+	// fills moves with the legal moves of the given kind made by the pieces on the given squares
+	void generateLegal(
+		MoveList* moves,
+		GenType type,
+		const LegalityMasks& masks,
+		Bitboard pieceSquares = ~0ULL
 	);
 
-	// generates moves for rooks
-	void generateRookMoves(
-		unsigned char row,
-		unsigned char col,
-		vector<string>* pseudoLegalMoves,
-		unordered_set<unsigned char>* pinnedPieces,
-		unsigned char kingRow,
-		unsigned char kingCol
+	// generates a move for each target square
+	void generateMoves(
+		unsigned char square,
+		Bitboard targets,
+		MoveList* moves
 	);
 
-	// generates moves for pawns
+	// generates moves for a pawn, limited to the target squares
 	void generatePawnMoves(
-		unsigned char row,
-		unsigned char col,
-		vector<string>* pseudoLegalMoves,
-		unordered_set<unsigned char>* pinnedPieces,
-		unsigned char kingRow,
-		unsigned char kingCol
+		unsigned char square,
+		Bitboard targets,
+		MoveList* moves
 	);
 
-	// returns true if all 3 points are on the same line
-	bool onLine(
-		unsigned char anchorRow,
-		unsigned char anchorCol,
-		unsigned char pointOneRow,
-		unsigned char pointOneCol,
-		unsigned char pointTwoRow,
-		unsigned char pointTwoCol
+	// generates en passant captures by the pawns on the given squares
+	void generateEnPassant(
+		unsigned char kingSquare,
+		Bitboard checkMask,
+		Bitboard pieceSquares,
+		MoveList* moves
 	);
 
-	// returns true if the number is strictly between lower and upper
-	bool isBetween(
-		unsigned char number,
-		unsigned char lower,
-		unsigned char upper
+	// generates castle moves
+	void generateCastles(
+		unsigned char kingSquare,
+		Bitboard kingDangerSquares,
+		MoveList* moves
 	);
 
 	// returns a char representing a square on the board
@@ -0,0 +1,77 @@
+#include <cmath>
+#include <algorithm>
+#include "SearchParameters.h"
+
+using namespace std;
+
+// a setting's name and where it is stored
+struct NamedParameter {
+	const char* name;
+	int SearchParameters::* value;
+};
+
+const NamedParameter namedParameters[] = {
+	{ "nullMoveDepth", &SearchParameters::nullMoveDepth },
+	{ "nullMoveReduction", &SearchParameters::nullMoveReduction },
+	{ "reverseFutilityDepth", &SearchParameters::reverseFutilityDepth },
+	{ "reverseFutilityMargin", &SearchParameters::reverseFutilityMargin },
+	{ "futilityDepth", &SearchParameters::futilityDepth },
+	{ "futilityBase", &SearchParameters::futilityBase },
+	{ "futilityMargin", &SearchParameters::futilityMargin },
+	{ "lateMovePruningDepth", &SearchParameters::lateMovePruningDepth },
+	{ "lateMovePruningBase", &SearchParameters::lateMovePruningBase },
+	{ "reductionDepth", &SearchParameters::reductionDepth },
+	{ "reductionMoves", &SearchParameters::reductionMoves },
+	{ "reductionBase", &SearchParameters::reductionBase },
+	{ "reductionDivisor", &SearchParameters::reductionDivisor }
+};
+
+// works out the reduction table
+SearchParameters::SearchParameters() {
+	computeReductions();
+}
+
+// changes the setting with the given name and works out the reduction table again | returns false if there is no such setting
+bool SearchParameters::set(
+	string name,
+	int value
+) {
+	for (const NamedParameter& parameter : namedParameters) {
+		if (name == parameter.name) {
+			this->*parameter.value = value;
+			computeReductions();
+			return true;
+		}
+	}
+	return false;
+}
+
+// returns the name of every setting
+vector<string> SearchParameters::names() {
+	vector<string> out;
+	for (const NamedParameter& parameter : namedParameters) {
+		out.push_back(parameter.name);
+	}
+	return out;
+}
+
+// returns the value of the setting with the given name | 0 if there is no such setting
+int SearchParameters::get(string name) const {
+	for (const NamedParameter& parameter : namedParameters) {
+		if (name == parameter.name) {
+			return this->*parameter.value;
+		}
+	}
+	return 0;
+}
+
+// works out the reduction table from the settings
+void SearchParameters::computeReductions() {
+	double divisor = max(reductionDivisor, 1) / 100.0;
+	for (int depth = 0; depth < 64; depth++) {
+		for (int move = 0; move < 64; move++) {
+			double reduction = depth && move ? reductionBase / 100.0 + log(depth) * log(move) / divisor : 0;
+			reductions[depth][move] = (unsigned char)min(max(reduction, 0.0), 63.0);
+		}
+	}
+}
\ No newline at end of file
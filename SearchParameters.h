@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// the settings of the search's pruning and reductions | every one can be changed at runtime by name
+// depths are in plies and margins in centipawns
+struct SearchParameters {
+	int nullMoveDepth = 3;				// shallowest depth null move pruning is tried at
+	int nullMoveReduction = 3;			// depth taken off the null move search, before it grows with depth and the margin over beta
+	int reverseFutilityDepth = 7;		// deepest depth a position far enough above beta is cut off at without a search
+	int reverseFutilityMargin = 80;		// how far above beta the static evaluation must be, per ply of depth
+	int futilityDepth = 6;				// deepest depth quiet moves are skipped at when the static evaluation is far below alpha
+	int futilityBase = 80;				// how far below alpha the static evaluation must be at depth 0
+	int futilityMargin = 90;			// how much further below alpha it must be per ply of depth
+	int lateMovePruningDepth = 4;		// deepest depth late quiet moves are skipped at
+	int lateMovePruningBase = 3;		// quiet moves searched at depth d before the rest are skipped is this plus d * d
+	int reductionDepth = 3;				// shallowest depth late moves are reduced at
+	int reductionMoves = 3;				// moves searched at full depth before reductions start
+	int reductionBase = 75;				// reduction of every late move, in hundredths of a ply
+	int reductionDivisor = 225;			// the reduction grows by ln(depth) * ln(move number) divided by this, in hundredths
+
+	unsigned char reductions[64][64];	// late move reduction for each depth and move number, worked out from the settings above
+
+	// works out the reduction table
+	SearchParameters();
+
+	// changes the setting with the given name and works out the reduction table again | returns false if there is no such setting
+	bool set(
+		string name,
+		int value
+	);
+
+	// returns the name of every setting
+	static vector<string> names();
+
+	// returns the value of the setting with the given name | 0 if there is no such setting
+	int get(string name) const;
+
+	// works out the reduction table from the settings
+	void computeReductions();
+};
\ No newline at end of file
@@ -0,0 +1,533 @@
+#include <algorithm>
+#include "SearchThread.h"
+#include "MovePicker.h"
+
+using namespace std;
+
+// helpers skip some depths so that at any moment the threads are spread over several depths instead of all searching the same one
+// helper i searches a depth only if ((depth + skipPhase[i]) / skipSize[i]) is even
+const int skipSize[20] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+const int skipPhase[20] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7 };
+
+#pragma region constructors
+
+// constructs a thread that searches with the given table and settings under the given control | id 0 is the main thread
+SearchThread::SearchThread(
+	unsigned int tid,
+	TranspositionTable* ttable,
+	const SearchParameters* tparameters,
+	SearchControl* tcontrol
+) :
+	id(tid),
+	table(ttable),
+	parameters(tparameters),
+	control(tcontrol)
+{
+	history.clear();
+}
+
+#pragma endregion
+
+#pragma region general functions
+
+// searches the position one depth at a time until maxDepth is done or the search is stopped
+// the results of the deepest finished iteration are kept in completedDepth, completedScore and completedPv
+void SearchThread::iterate(
+	Position position,
+	int maxDepth
+) {
+	completedDepth = 0;
+	completedScore = 0;
+	completedPv.clear();
+	nodes = 0;
+	fill(&killers[0][0], &killers[0][0] + sizeof(killers) / sizeof(Move), Move::none());
+
+	for (int depth = 1; depth <= min(maxDepth, MAX_PLY - 1); depth++) {
+		if (id > 0) {
+			int i = (id - 1) % 20;
+			if (((depth + skipPhase[i]) / skipSize[i]) % 2) {
+				continue;
+			}
+		}
+
+		int iterationScore = aspirationSearch(&position, depth, completedDepth > 0, completedScore);
+		if (stopped()) {
+			break;
+		}
+
+		// the result of every completed iteration is kept, so a best move is always available
+		// the line is only copied out of the pv table here, once per iteration
+		completedDepth = depth;
+		completedScore = iterationScore;
+		completedPv.assign(pvTable[0], pvTable[0] + pvLength[0]);
+
+		if (id == 0 && control->onIteration) {
+			Evaluation update = evaluation(position.whiteMove);
+			update.nodes = control->nodes.load(memory_order_relaxed) + (nodes % NODE_BATCH);
+			control->onIteration(update);
+		}
+	}
+}
+
+// returns the result of the deepest finished iteration for a root where white is to move if whiteMove is true
+Evaluation SearchThread::evaluation(bool whiteMove) {
+	Evaluation out;
+	out.eval = (whiteMove ? completedScore : -completedScore) / 100.0;
+	out.line = completedPv;
+	out.bestMove = completedPv.empty() ? Move::none() : completedPv.front();
+	out.depth = (unsigned short int)completedDepth;
+	out.nodes = nodes;
+
+	// mate scores count plies from the root, so the mating side's moves are half of them rounded up
+	// a root that is already checkmated has no moves to count, so it is flagged instead
+	if (abs(completedScore) >= MATE_BOUND && completedDepth > 0) {
+		short int moves = (short int)((MATE_SCORE - abs(completedScore) + 1) / 2);
+		out.mate = (completedScore > 0) == whiteMove ? moves : -moves;
+		out.checkmated = completedScore == -MATE_SCORE;
+	}
+	return out;
+}
+
+// forgets the move ordering statistics and pawn structure evaluations kept from earlier searches
+void SearchThread::clearHistory() {
+	history.clear();
+	pawnTable.clear();
+}
+
+#pragma endregion
+
+#pragma region helper functions
+
+// searches the root with a narrow window around the previous score, widening it whenever the score falls outside
+// the first iteration this thread finishes has no previous score, so it always gets the full window
+int SearchThread::aspirationSearch(
+	Position* position,
+	int depth,
+	bool hasPreviousScore,
+	int previousScore
+) {
+	int delta = ASPIRATION_WINDOW;
+	int alpha = -INFINITE_SCORE;
+	int beta = INFINITE_SCORE;
+	if (hasPreviousScore && depth >= ASPIRATION_DEPTH) {
+		alpha = max(previousScore - delta, -INFINITE_SCORE);
+		beta = min(previousScore + delta, INFINITE_SCORE);
+	}
+
+	while (true) {
+		followingPv = true;
+		int score = search(position, alpha, beta, depth, 0);
+		if (stopped()) {
+			return score;
+		}
+
+		// fail low | the line is not trusted, so the window is widened downwards and the root searched again
+		if (score <= alpha && alpha > -INFINITE_SCORE) {
+			beta = (alpha + beta) / 2;
+			alpha = max(score - delta, -INFINITE_SCORE);
+		}
+
+		// fail high
+		else if (score >= beta && beta < INFINITE_SCORE) {
+			beta = min(score + delta, INFINITE_SCORE);
+		}
+		else {
+			return score;
+		}
+
+		delta *= 2;
+		if (delta > 1000) {
+			alpha = -INFINITE_SCORE;
+			beta = INFINITE_SCORE;
+		}
+	}
+}
+
+// returns the previous iteration's move for this ply while the search is still on its line | Move::none() otherwise
+Move SearchThread::pvMoveAt(int ply) {
+	Move move = followingPv && ply < (int)completedPv.size() ? completedPv[ply] : Move::none();
+	followingPv = false;
+	return move;
+}
+
+// converts a mate score relative to the root into one relative to the position at ply, for storing in the table
+int SearchThread::scoreToTT(
+	int score,
+	int ply
+) {
+	return score >= MATE_BOUND ? score + ply : score <= -MATE_BOUND ? score - ply : score;
+}
+
+// converts a mate score read from the table back into one relative to the root
+int SearchThread::scoreFromTT(
+	int score,
+	int ply
+) {
+	return score >= MATE_BOUND ? score - ply : score <= -MATE_BOUND ? score + ply : score;
+}
+
+// returns the score of the position from the side to move's point of view in centipawns
+// a window wider than one centipawn makes this a pv node, whose best line is left in pvTable[ply]
+int SearchThread::search(
+	Position* position,
+	int alpha,
+	int beta,
+	int depth,
+	int ply
+) {
+	pvLength[ply] = ply;
+	keyHistory[ply] = position->key;
+	bool pvNode = beta - alpha > 1;
+
+	if (ply > 0 && (position->fiftyMoveRule >= 100 || isRepetition(position, ply))) {
+		followingPv = false;
+		return 0;
+	}
+
+	// the leaves play out the captures on the board instead of trusting the static evaluation
+	if (depth <= 0 || ply >= MAX_PLY) {
+		followingPv = false;
+		return quiescence(position, alpha, beta, ply);
+	}
+
+	countNode();
+	if (stopped()) {
+		return 0;
+	}
+
+	// a result from the table that is deep enough and fits the window ends the search here
+	// pv nodes always search, so the line they return is never cut short by the table
+	TTData ttData;
+	bool ttHit = table->probe(position->key, &ttData);
+	if (ttHit && !pvNode && ttData.depth >= depth) {
+		int ttScore = scoreFromTT(ttData.score, ply);
+		if (
+			ttData.bound == BOUND_EXACT ||
+			(ttData.bound == BOUND_LOWER && ttScore >= beta) ||
+			(ttData.bound == BOUND_UPPER && ttScore <= alpha)
+		) {
+			followingPv = false;
+			return ttScore;
+		}
+	}
+
+	bool check = position->inCheck();
+	Color us = position->whiteMove ? WHITE : BLACK;
+	int staticEval = check ? -INFINITE_SCORE : evaluate(position);
+
+	// the pruning below is only done at null window nodes, so the principal variation is always searched in full
+	bool prunable = ply > 0 && !pvNode && !check;
+
+	// reverse futility pruning | a position so far above beta at a shallow depth is not searched at all
+	if (
+		prunable &&
+		depth <= parameters->reverseFutilityDepth &&
+		abs(beta) < MATE_BOUND &&
+		staticEval - parameters->reverseFutilityMargin * depth >= beta
+	) {
+		return staticEval;
+	}
+
+	// null move pruning | if passing the turn still leaves the side to move above beta, a real move almost surely does as well
+	// never done twice in a row, or with only king and pawns, where passing can be better than any move
+	if (
+		prunable &&
+		depth >= parameters->nullMoveDepth &&
+		moveStack[ply - 1] != Move::none() &&
+		beta < MATE_BOUND &&
+		staticEval >= beta &&
+		position->hasPieces(us)
+	) {
+		int reduction = parameters->nullMoveReduction + depth / 4 + min((staticEval - beta) / 200, 3);
+		moveStack[ply] = Move::none();
+		Undo undo = position->makeNullMove();
+		int score = -search(position, -beta, -beta + 1, depth - 1 - reduction, ply + 1);
+		position->unmakeNullMove(undo);
+		if (stopped()) {
+			return 0;
+		}
+
+		// a mate found after passing is not proven, so only beta is claimed
+		if (score >= beta) {
+			return score >= MATE_BOUND ? beta : score;
+		}
+	}
+
+	// while the search is still on the previous iteration's line, its move is tried before the table's
+	Move pvMove = pvMoveAt(ply);
+	Move previous = ply > 0 ? moveStack[ply - 1] : Move::none();
+	const short* continuations[2] = { continuationRow(ply - 1), continuationRow(ply - 2) };
+	MovePicker picker(
+		position,
+		pvMove != Move::none() ? pvMove : ttHit ? ttData.move : Move::none(),
+		killers[ply],
+		previous != Move::none() ? history.counterMoves[pieceStack[ply - 1]][previous.end()] : Move::none(),
+		&history,
+		continuations
+	);
+
+	int bestScore = -INFINITE_SCORE;
+	Move bestMove = Move::none();
+	unsigned short int moveCount = 0;
+	Move quiets[64];
+	unsigned char quietCount = 0;
+	Move move;
+	while ((move = picker.next()) != Move::none()) {
+		moveCount++;
+		bool quiet = !position->isCapture(move);
+		moveStack[ply] = move;
+		pieceStack[ply] = (us * 6) + position->pieceOn(move.start());
+
+		// only the first child can still be on the line
+		followingPv = moveCount == 1 && move == pvMove;
+
+		Undo undo = position->makeMove(move);
+		bool givesCheck = position->inCheck();
+		bool late = prunable && quiet && !givesCheck && bestScore > -MATE_BOUND;
+
+		// late move pruning and futility pruning | at shallow depths, late quiet moves and quiet moves that cannot lift the score to alpha are skipped
+		if (
+			late &&
+			(
+				(depth <= parameters->lateMovePruningDepth && moveCount > parameters->lateMovePruningBase + depth * depth) ||
+				(depth <= parameters->futilityDepth && staticEval + parameters->futilityBase + parameters->futilityMargin * depth <= alpha)
+			)
+		) {
+			position->unmakeMove(move, undo);
+			continue;
+		}
+
+		// late move reductions | later quiet moves are searched shallower first, and again at full depth only if they beat alpha
+		int reduction = 0;
+		if (late && depth >= parameters->reductionDepth && moveCount > parameters->reductionMoves) {
+			reduction = parameters->reductions[min(depth, 63)][min((int)moveCount, 63)];
+			if (move == killers[ply][0] || move == killers[ply][1]) {
+				reduction--;
+			}
+			reduction = max(min(reduction, depth - 2), 0);
+		}
+
+		// principal variation search | only the first move of a pv node gets the full window
+		// the rest are expected to fail low, so a null window proves it cheaply, and only a move that beats alpha is searched again with the full window
+		int score;
+		if (pvNode && moveCount == 1) {
+			score = -search(position, -beta, -alpha, depth - 1, ply + 1);
+		}
+		else {
+			score = -search(position, -alpha - 1, -alpha, depth - 1 - reduction, ply + 1);
+			if (reduction > 0 && score > alpha && !stopped()) {
+				score = -search(position, -alpha - 1, -alpha, depth - 1, ply + 1);
+			}
+			if (pvNode && score > alpha && score < beta && !stopped()) {
+				score = -search(position, -beta, -alpha, depth - 1, ply + 1);
+			}
+		}
+		position->unmakeMove(move, undo);
+		if (stopped()) {
+			return 0;
+		}
+
+		if (score > bestScore) {
+			bestScore = score;
+			if (score > alpha) {
+				alpha = score;
+				bestMove = move;
+				if (pvNode) {
+					pvTable[ply][ply] = move;
+					copy(pvTable[ply + 1] + ply + 1, pvTable[ply + 1] + pvLength[ply + 1], pvTable[ply] + ply + 1);
+					pvLength[ply] = pvLength[ply + 1];
+				}
+				if (alpha >= beta) {
+					if (quiet) {
+						updateQuietHistory(position, ply, depth, move, quiets, quietCount);
+					}
+					break;
+				}
+			}
+		}
+		if (quiet && quietCount < 64) {
+			quiets[quietCount++] = move;
+		}
+	}
+
+	// checkmate or stalemate | quicker mates score higher
+	if (moveCount == 0) {
+		return check ? -MATE_SCORE + ply : 0;
+	}
+
+	table->store(
+		position->key,
+		bestMove,
+		scoreToTT(bestScore, ply),
+		depth,
+		bestScore >= beta ? BOUND_LOWER : bestMove != Move::none() ? BOUND_EXACT : BOUND_UPPER
+	);
+	return bestScore;
+}
+
+// returns the score of the position once the captures on the board have been played out, from the side to move's point of view in centipawns
+// the side to move may stand pat on the static evaluation instead of capturing, unless it is in check, in which case every evasion is searched
+int SearchThread::quiescence(
+	Position* position,
+	int alpha,
+	int beta,
+	int ply
+) {
+	pvLength[ply] = ply;
+	countNode();
+	if (stopped()) {
+		return 0;
+	}
+	if (ply >= MAX_PLY) {
+		return evaluate(position);
+	}
+
+	int bestScore = -INFINITE_SCORE;
+	bool check = position->inCheck();
+	if (!check) {
+		bestScore = evaluate(position);
+		if (bestScore >= beta) {
+			return bestScore;
+		}
+		alpha = max(alpha, bestScore);
+	}
+
+	// captures that lose material are not searched, since standing pat is at least as good | every evasion is searched
+	MovePicker picker(position, check, &history);
+	Move move;
+	while ((move = picker.next()) != Move::none()) {
+		Undo undo = position->makeMove(move);
+		int score = -quiescence(position, -beta, -alpha, ply + 1);
+		position->unmakeMove(move, undo);
+		if (stopped()) {
+			return 0;
+		}
+
+		if (score > bestScore) {
+			bestScore = score;
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta) {
+					break;
+				}
+			}
+		}
+	}
+
+	// checkmate | quicker mates score higher
+	if (check && bestScore == -INFINITE_SCORE) {
+		return -MATE_SCORE + ply;
+	}
+	return bestScore;
+}
+
+// rewards the quiet move that caused a cutoff and punishes the quiet moves searched before it
+void SearchThread::updateQuietHistory(
+	Position* position,
+	int ply,
+	int depth,
+	Move best,
+	const Move* quiets,
+	unsigned char quietCount
+) {
+	if (killers[ply][0] != best) {
+		killers[ply][1] = killers[ply][0];
+		killers[ply][0] = best;
+	}
+	if (ply > 0 && moveStack[ply - 1] != Move::none()) {
+		history.counterMoves[pieceStack[ply - 1]][moveStack[ply - 1].end()] = best;
+	}
+
+	// deeper cutoffs say more about a move
+	int bonus = min(32 * depth * depth, 1536);
+	updateQuiet(position, ply, best, bonus);
+	for (unsigned char i = 0; i < quietCount; i++) {
+		updateQuiet(position, ply, quiets[i], -bonus);
+	}
+}
+
+// moves the statistics of one quiet move by the bonus
+void SearchThread::updateQuiet(
+	Position* position,
+	int ply,
+	Move move,
+	int bonus
+) {
+	Color us = position->whiteMove ? WHITE : BLACK;
+	unsigned char piece = (us * 6) + position->pieceOn(move.start());
+	History::update(&history.butterfly[us][move.start()][move.end()], bonus);
+	for (int i = 1; i <= 2; i++) {
+		if (ply - i >= 0 && moveStack[ply - i] != Move::none()) {
+			History::update(&history.continuation[pieceStack[ply - i]][moveStack[ply - i].end()][piece][move.end()], bonus);
+		}
+	}
+}
+
+// returns the continuation history row of the move played at the given ply | nullptr if there is none
+const short* SearchThread::continuationRow(int ply) {
+	if (ply < 0 || moveStack[ply] == Move::none()) {
+		return nullptr;
+	}
+	return &history.continuation[pieceStack[ply]][moveStack[ply].end()][0][0];
+}
+
+// returns the static evaluation of the position from the side to move's point of view in centipawns | material, piece squares and pawn structure
+// the one evaluation of the engine | Position only keeps the running piece square sums it starts from
+int SearchThread::evaluate(Position* position) {
+	int midgameScore = position->midgameScore;
+	int endgameScore = position->endgameScore;
+	pawnTable.evaluate(position, &midgameScore, &endgameScore);
+	int score = PieceSquare::taper(midgameScore, endgameScore, position->phase);
+	return position->whiteMove ? score : -score;
+}
+
+// returns true if the position at the given ply repeats an earlier one since the last capture or pawn move
+bool SearchThread::isRepetition(
+	Position* position,
+	int ply
+) {
+	int earliest = max(ply - (int)position->fiftyMoveRule, 0);
+	for (int i = ply - 1; i >= earliest; i--) {
+
+		// the positions before a null move were never really left
+		if (moveStack[i] == Move::none()) {
+			return false;
+		}
+		if ((ply - i) % 2 == 0 && ply - i >= 4 && keyHistory[i] == position->key) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// counts a visited position and checks the limits once every NODE_BATCH positions
+void SearchThread::countNode() {
+	nodes++;
+	if (nodes % NODE_BATCH == 0) {
+		checkLimits();
+	}
+}
+
+// adds the last batch of nodes to the shared count and stops the search if it has run out of nodes or time
+void SearchThread::checkLimits() {
+	unsigned long long totalNodes = control->nodes.fetch_add(NODE_BATCH, memory_order_relaxed) + NODE_BATCH;
+	unsigned long long nodeLimit = control->nodeLimit.load(memory_order_relaxed);
+	if (nodeLimit && totalNodes >= nodeLimit) {
+		control->stop.store(true, memory_order_relaxed);
+	}
+
+	unsigned long long timeLimit = control->timeLimit.load(memory_order_relaxed);
+	if (timeLimit) {
+		auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - control->startTime);
+		if ((unsigned long long)elapsed.count() >= timeLimit) {
+			control->stop.store(true, memory_order_relaxed);
+		}
+	}
+}
+
+// returns true once the search has been told to stop
+bool SearchThread::stopped() {
+	return control->stop.load(memory_order_relaxed);
+}
+
+#pragma endregion
\ No newline at end of file
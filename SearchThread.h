@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "Position.h"
+#include "Evaluation.h"
+#include "TranspositionTable.h"
+#include "History.h"
+#include "PawnTable.h"
+#include "SearchParameters.h"
+
+using namespace std;
+
+const int MAX_PLY = 128;						// deepest ply the search can reach
+const int MATE_SCORE = 32000;					// score of checkmating on the current move
+const int INFINITE_SCORE = 32001;				// bound wider than any real score
+const int MATE_BOUND = MATE_SCORE - MAX_PLY;	// scores beyond this are forced mates
+const int ASPIRATION_DEPTH = 4;					// first iteration searched with a narrow window
+const int ASPIRATION_WINDOW = 25;				// starting distance of the window from the previous score
+const unsigned long long NODE_BATCH = 1024;		// nodes a thread searches between checks of the node and time limits
+
+// state shared by every thread of one search | the stop flag and limits may be changed from any thread while it runs
+struct SearchControl {
+	atomic<bool> stop;									// set when every thread should give up its current iteration
+	atomic<unsigned long long> nodes;					// positions visited by every thread, counted in batches of NODE_BATCH
+	atomic<unsigned long long> nodeLimit;				// the search stops once nodes reaches this | 0 for no limit
+	atomic<unsigned long long> timeLimit;				// the search stops this many milliseconds after startTime | 0 for no limit
+	chrono::steady_clock::time_point startTime;			// when the search started
+	function<void(const Evaluation&)> onIteration;		// called by the main thread after every completed iteration | may be empty
+
+	SearchControl() :
+		stop(false),
+		nodes(0),
+		nodeLimit(0),
+		timeLimit(0)
+	{}
+};
+
+// one thread of a lazy smp search
+// every thread searches the same root on its own copy of the position and they share nothing but the transposition table
+// the threads only help each other through the entries they leave in the table, so helpers search slightly different depths to fill it with different results
+class SearchThread {
+public:
+
+#pragma region constructors
+
+	// constructs a thread that searches with the given table and settings under the given control | id 0 is the main thread
+	SearchThread(
+		unsigned int tid,
+		TranspositionTable* ttable,
+		const SearchParameters* tparameters,
+		SearchControl* tcontrol
+	);
+
+#pragma endregion
+
+#pragma region general functions
+
+	// searches the position one depth at a time until maxDepth is done or the search is stopped
+	// the results of the deepest finished iteration are kept in completedDepth, completedScore and completedPv
+	void iterate(
+		Position position,
+		int maxDepth
+	);
+
+	// returns the result of the deepest finished iteration for a root where white is to move if whiteMove is true
+	Evaluation evaluation(bool whiteMove);
+
+	// forgets the move ordering statistics and pawn structure evaluations kept from earlier searches
+	void clearHistory();
+
+#pragma endregion
+
+#pragma region variables
+
+	unsigned int id;						// 0 for the main thread
+	int completedDepth = 0;					// deepest iteration finished by the last call to iterate
+	int completedScore = 0;					// score of that iteration from the side to move's point of view in centipawns
+	vector<Move> completedPv;				// principal variation of that iteration
+	unsigned long long nodes = 0;			// positions visited by the last call to iterate
+
+#pragma endregion
+
+private:
+
+#pragma region variables
+
+	TranspositionTable* table;							// shared by every thread
+	const SearchParameters* parameters;					// pruning and reduction settings, shared by every thread
+	SearchControl* control;								// shared by every thread
+	unsigned long long keyHistory[MAX_PLY + 1] = {};	// zobrist keys of the positions on the current line, used to find repetitions
+	Move moveStack[MAX_PLY + 1];						// move played at each ply of the current line
+	unsigned char pieceStack[MAX_PLY + 1];				// piece that played it, as (color * 6) + type
+	Move killers[MAX_PLY + 1][2];						// the last two quiet moves that caused a cutoff at each ply of this search
+	History history;									// quiet move statistics, kept between searches
+	PawnTable pawnTable;								// pawn structure evaluations, kept between searches
+	bool followingPv = false;							// true while the search is still on completedPv
+	Move pvTable[MAX_PLY + 1][MAX_PLY + 1];				// best line found from each ply of the current line | row ply holds it from column ply on
+	unsigned char pvLength[MAX_PLY + 1];				// end of each row of pvTable
+
+#pragma endregion
+
+#pragma region helper functions
+
+	// returns the score of the position from the side to move's point of view in centipawns
+	// a window wider than one centipawn makes this a pv node, whose best line is left in pvTable[ply]
+	// returns 0 once stop is set | the caller must throw the result away
+	int search(
+		Position* position,
+		int alpha,
+		int beta,
+		int depth,
+		int ply
+	);
+
+	// returns the score of the position once the captures on the board have been played out, from the side to move's point of view in centipawns
+	// the side to move may stand pat on the static evaluation instead of capturing, unless it is in check, in which case every evasion is searched
+	int quiescence(
+		Position* position,
+		int alpha,
+		int beta,
+		int ply
+	);
+
+	// searches the root with a narrow window around the previous score, widening it whenever the score falls outside
+	// the first iteration this thread finishes has no previous score, so it always gets the full window
+	int aspirationSearch(
+		Position* position,
+		int depth,
+		bool hasPreviousScore,
+		int previousScore
+	);
+
+	// returns the previous iteration's move for this ply while the search is still on its line | Move::none() otherwise
+	Move pvMoveAt(int ply);
+
+	// converts a mate score relative to the root into one relative to the position at ply, for storing in the table
+	int scoreToTT(
+		int score,
+		int ply
+	);
+
+	// converts a mate score read from the table back into one relative to the root
+	int scoreFromTT(
+		int score,
+		int ply
+	);
+
+	// rewards the quiet move that caused a cutoff and punishes the quiet moves searched before it
+	void updateQuietHistory(
+		Position* position,
+		int ply,
+		int depth,
+		Move best,
+		const Move* quiets,
+		unsigned char quietCount
+	);
+
+	// moves the statistics of one quiet move by the bonus
+	void updateQuiet(
+		Position* position,
+		int ply,
+		Move move,
+		int bonus
+	);
+
+	// returns the continuation history row of the move played at the given ply | nullptr if there is none
+	const short* continuationRow(int ply);
+
+	// returns the static evaluation of the position from the side to move's point of view in centipawns | material, piece squares and pawn structure
+	// the one evaluation of the engine | Position only keeps the running piece square sums it starts from
+	int evaluate(Position* position);
+
+	// returns true if the position at the given ply repeats an earlier one since the last capture or pawn move
+	bool isRepetition(
+		Position* position,
+		int ply
+	);
+
+	// counts a visited position and checks the limits once every NODE_BATCH positions
+	void countNode();
+
+	// adds the last batch of nodes to the shared count and stops the search if it has run out of nodes or time
+	void checkLimits();
+
+	// returns true once the search has been told to stop
+	bool stopped();
+
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include "ThreadPool.h"
+
+using namespace std;
+
+#pragma region constructors
+
+// starts the given number of worker threads | at least one is always started
+ThreadPool::ThreadPool(unsigned int threadCount) :
+	queued(0),
+	pending(0),
+	nextQueue(0)
+{
+	threadCount = max(threadCount, 1u);
+	for (unsigned int i = 0; i < threadCount; i++) {
+		queues.push_back(unique_ptr<Queue>(new Queue()));
+	}
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.push_back(thread(&ThreadPool::run, this, i));
+	}
+}
+
+// waits for the queued tasks to finish and stops the workers
+ThreadPool::~ThreadPool() {
+	wait();
+	{
+		lock_guard<mutex> lock(sleepLock);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (unsigned int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+}
+
+#pragma endregion
+
+#pragma region general functions
+
+// queues a task to be run by one of the workers
+void ThreadPool::submit(function<void()> task) {
+	pending++;
+	Queue& queue = *queues[nextQueue++ % queues.size()];
+	{
+		lock_guard<mutex> lock(queue.lock);
+		queue.tasks.push_back(move(task));
+	}
+	queued++;
+
+	// taking the lock makes sure a worker that just found every queue empty is already waiting
+	lock_guard<mutex> lock(sleepLock);
+	wake.notify_one();
+}
+
+// blocks until every submitted task has finished
+void ThreadPool::wait() {
+	unique_lock<mutex> lock(sleepLock);
+	finished.wait(lock, [this] { return pending == 0; });
+}
+
+// returns the number of worker threads
+unsigned int ThreadPool::size() {
+	return (unsigned int)workers.size();
+}
+
+#pragma endregion
+
+#pragma region helper functions
+
+// runs tasks until the pool stops
+void ThreadPool::run(unsigned int index) {
+	function<void()> task;
+	while (true) {
+		if (takeTask(index, &task)) {
+			task();
+			task = nullptr;
+			if (--pending == 0) {
+				lock_guard<mutex> lock(sleepLock);
+				finished.notify_all();
+			}
+			continue;
+		}
+
+		unique_lock<mutex> lock(sleepLock);
+		wake.wait(lock, [this] { return stopping || queued > 0; });
+		if (stopping && queued == 0) {
+			return;
+		}
+	}
+}
+
+// takes a task from the worker's own queue, or steals one from another queue
+// returns false if every queue is empty
+bool ThreadPool::takeTask(
+	unsigned int index,
+	function<void()>* task
+) {
+	{
+		Queue& own = *queues[index];
+		lock_guard<mutex> lock(own.lock);
+		if (!own.tasks.empty()) {
+			*task = move(own.tasks.back());
+			own.tasks.pop_back();
+			queued--;
+			return true;
+		}
+	}
+
+	for (unsigned int i = 1; i < queues.size(); i++) {
+		Queue& other = *queues[(index + i) % queues.size()];
+		lock_guard<mutex> lock(other.lock);
+		if (!other.tasks.empty()) {
+			*task = move(other.tasks.front());
+			other.tasks.pop_front();
+			queued--;
+			return true;
+		}
+	}
+	return false;
+}
+
+#pragma endregion
\ No newline at end of file
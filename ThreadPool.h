@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// a fixed set of worker threads that run submitted tasks
+// every worker has its own queue and takes work from the other queues when its own runs out
+class ThreadPool {
+public:
+
+#pragma region constructors
+
+	// starts the given number of worker threads | at least one is always started
+	ThreadPool(unsigned int threadCount);
+
+	// waits for the queued tasks to finish and stops the workers
+	~ThreadPool();
+
+#pragma endregion
+
+#pragma region general functions
+
+	// queues a task to be run by one of the workers
+	void submit(function<void()> task);
+
+	// blocks until every submitted task has finished
+	void wait();
+
+	// returns the number of worker threads
+	unsigned int size();
+
+#pragma endregion
+
+private:
+
+	// a worker's queue | the owner takes tasks from the back and other workers steal from the front
+	struct Queue {
+		deque<function<void()>> tasks;
+		mutex lock;
+	};
+
+#pragma region variables
+
+	vector<unique_ptr<Queue>> queues;	// one queue per worker
+	vector<thread> workers;				// the worker threads
+	mutex sleepLock;					// guards sleeping and waking
+	condition_variable wake;			// signalled when a task is queued or the pool stops
+	condition_variable finished;		// signalled when the last pending task finishes
+	atomic<unsigned int> queued;		// tasks waiting in the queues
+	atomic<unsigned int> pending;		// tasks submitted but not yet finished
+	atomic<unsigned int> nextQueue;		// queue that receives the next submitted task
+	bool stopping = false;				// true once the destructor has been called
+
+#pragma endregion
+
+#pragma region helper functions
+
+	// runs tasks until the pool stops
+	void run(unsigned int index);
+
+	// takes a task from the worker's own queue, or steals one from another queue
+	// returns false if every queue is empty
+	bool takeTask(
+		unsigned int index,
+		function<void()>* task
+	);
+
+#pragma endregion
+};
\ No newline at end of file
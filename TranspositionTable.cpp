@@ -0,0 +1,314 @@
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <new>
+#include "TranspositionTable.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#pragma comment(lib, "advapi32.lib")
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+const size_t LARGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+using namespace std;
+
+#pragma region constructors
+
+// allocates a table using about the given number of megabytes
+TranspositionTable::TranspositionTable(unsigned int megabytes) {
+	resize(megabytes);
+}
+
+// frees the table
+TranspositionTable::~TranspositionTable() {
+	release();
+}
+
+#pragma endregion
+
+#pragma region general functions
+
+// reallocates the table with about the given number of megabytes | the old entries are lost
+void TranspositionTable::resize(unsigned int megabytes) {
+	unsigned long long count = 1;
+	while (count * 2 * sizeof(Bucket) <= (unsigned long long)megabytes << 20) {
+		count *= 2;
+	}
+	release();
+	allocate(count);
+	clear();
+
+	// transparent huge pages are only handed out as the table is first written, so whether any were obtained is only known once it is cleared
+	if (mode == TRANSPARENT_HUGE_PAGES && !backedByHugePages(buckets)) {
+		mode = NORMAL_PAGES;
+	}
+}
+
+// empties the table
+void TranspositionTable::clear() {
+	memset((void*)buckets, 0, bucketCount * sizeof(Bucket));
+	generation = 0;
+}
+
+// ages the entries of earlier searches so that they are replaced first
+void TranspositionTable::newSearch() {
+	generation = (generation + 1) & 63;
+}
+
+// returns true and sets data if the position is in the table
+bool TranspositionTable::probe(
+	unsigned long long key,
+	TTData* data
+) {
+	Bucket* bucket = bucketOf(key);
+	for (unsigned char i = 0; i < BUCKET_SIZE; i++) {
+		Entry& entry = bucket->entries[i];
+		unsigned long long word = entry.data.load(memory_order_relaxed);
+		if ((entry.check.load(memory_order_relaxed) ^ word) == key && word) {
+			data->move = Move((unsigned short int)word);
+			data->score = (short int)(word >> 16);
+			data->depth = (unsigned char)(word >> 32);
+			data->bound = Bound((word >> 40) & 3);
+			return true;
+		}
+	}
+	return false;
+}
+
+// stores the result of searching a position
+void TranspositionTable::store(
+	unsigned long long key,
+	Move move,
+	int score,
+	int depth,
+	Bound bound
+) {
+	Bucket* bucket = bucketOf(key);
+
+	// the entry of the same position is overwritten if there is one
+	// otherwise the entry that is shallowest once older searches are counted against it is replaced
+	Entry* replace = &bucket->entries[0];
+	int replaceValue = 1 << 30;
+	unsigned long long oldWord = 0;
+	for (unsigned char i = 0; i < BUCKET_SIZE; i++) {
+		Entry& entry = bucket->entries[i];
+		unsigned long long word = entry.data.load(memory_order_relaxed);
+		if ((entry.check.load(memory_order_relaxed) ^ word) == key) {
+
+			// a bound from a much shallower search, like a helper thread's, never replaces a deeper result of this search
+			// exact scores and entries left by earlier searches always give way
+			int oldDepth = (int)((word >> 32) & 0xFF);
+			if (bound != BOUND_EXACT && ((word >> 42) & 63) == generation && depth + 3 < oldDepth) {
+				return;
+			}
+			replace = &entry;
+			oldWord = word;
+			break;
+		}
+		int age = (generation - (int)((word >> 42) & 63)) & 63;
+		int value = (int)((word >> 32) & 0xFF) - 8 * age;
+		if (value < replaceValue) {
+			replace = &entry;
+			replaceValue = value;
+		}
+	}
+
+	// a shallow result without a move keeps the move already known for the position
+	if (move == Move::none()) {
+		move = Move((unsigned short int)oldWord);
+	}
+
+	unsigned long long word =
+		(unsigned long long)move.data |
+		((unsigned long long)(unsigned short int)score << 16) |
+		((unsigned long long)max(depth, 0) << 32) |
+		((unsigned long long)bound << 40) |
+		((unsigned long long)generation << 42);
+	replace->check.store(key ^ word, memory_order_relaxed);
+	replace->data.store(word, memory_order_relaxed);
+}
+
+// returns the size of the table in megabytes
+unsigned int TranspositionTable::megabytes() {
+	return (unsigned int)((bucketCount * sizeof(Bucket)) >> 20);
+}
+
+// returns the permille of sampled entries written during the current search
+unsigned int TranspositionTable::hashfull() {
+	unsigned long long samples = min(bucketCount, 250ULL);
+	unsigned int count = 0;
+	for (unsigned long long i = 0; i < samples; i++) {
+		for (unsigned char j = 0; j < BUCKET_SIZE; j++) {
+			unsigned long long word = buckets[i].entries[j].data.load(memory_order_relaxed);
+			if (word && ((word >> 42) & 63) == generation) {
+				count++;
+			}
+		}
+	}
+	return (unsigned int)(count * 1000 / (samples * BUCKET_SIZE));
+}
+
+// returns a description of the kind of pages the table was allocated in, for logging
+string TranspositionTable::pageModeName() {
+	switch (mode) {
+	case LARGE_PAGES:
+		return "large pages";
+	case TRANSPARENT_HUGE_PAGES:
+		return "transparent huge pages";
+	default:
+		return "normal pages";
+	}
+}
+
+#pragma endregion
+
+#pragma region helper functions
+
+// allocates room for the given number of buckets
+// large pages are tried first, since random probes into a big table miss the TLB on most normal pages
+void TranspositionTable::allocate(unsigned long long count) {
+	size_t bytes = (size_t)(count * sizeof(Bucket));
+	size_t largeBytes = (bytes + LARGE_PAGE_SIZE - 1) & ~(LARGE_PAGE_SIZE - 1);
+	memory = nullptr;
+	mode = NORMAL_PAGES;
+
+#if defined(_WIN32)
+
+	// needs the "lock pages in memory" privilege granted to the account, otherwise the normal pages below are used
+	SIZE_T minimum = GetLargePageMinimum();
+	if (minimum && bytes >= minimum && enableLockMemoryPrivilege()) {
+		size_t rounded = (bytes + minimum - 1) & ~(minimum - 1);
+		memory = VirtualAlloc(nullptr, rounded, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (memory) {
+			mode = LARGE_PAGES;
+			allocatedBytes = rounded;
+		}
+	}
+	if (!memory) {
+		allocatedBytes = bytes;
+		memory = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+#elif defined(__linux__)
+
+	// explicit huge pages only exist if the administrator has reserved them
+	if (bytes >= LARGE_PAGE_SIZE) {
+		memory = mmap(nullptr, largeBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (memory == MAP_FAILED) {
+			memory = nullptr;
+		}
+		else {
+			mode = LARGE_PAGES;
+		}
+	}
+
+	// otherwise the kernel is asked to back the table with transparent huge pages, which need 2 MB alignment
+	if (!memory) {
+		if (posix_memalign(&memory, LARGE_PAGE_SIZE, largeBytes) != 0) {
+			memory = nullptr;
+		}
+		else if (bytes >= LARGE_PAGE_SIZE && madvise(memory, largeBytes, MADV_HUGEPAGE) == 0) {
+
+			// only a request until resize checks what the kernel actually did
+			mode = TRANSPARENT_HUGE_PAGES;
+		}
+	}
+	allocatedBytes = largeBytes;
+
+#else
+
+	allocatedBytes = bytes + alignof(Bucket) - 1;
+	memory = malloc(allocatedBytes);
+
+#endif
+
+	if (!memory) {
+		throw bad_alloc();
+	}
+	buckets = (Bucket*)(((size_t)memory + alignof(Bucket) - 1) & ~(size_t)(alignof(Bucket) - 1));
+	bucketCount = count;
+}
+
+// frees the table
+void TranspositionTable::release() {
+	if (memory) {
+#if defined(_WIN32)
+		VirtualFree(memory, 0, MEM_RELEASE);
+#elif defined(__linux__)
+		if (mode == LARGE_PAGES) {
+			munmap(memory, allocatedBytes);
+		}
+		else {
+			free(memory);
+		}
+#else
+		free(memory);
+#endif
+	}
+	memory = nullptr;
+	buckets = nullptr;
+	bucketCount = 0;
+	allocatedBytes = 0;
+}
+
+// returns true if linux has backed any of the memory mapping holding the address with transparent huge pages
+bool TranspositionTable::backedByHugePages(const void* address) {
+	ifstream smaps("/proc/self/smaps");
+	string line;
+	bool inMapping = false;
+	while (getline(smaps, line)) {
+
+		// each mapping starts with a line like "7f0000000000-7f0000200000 rw-p ...", followed by its counters
+		size_t dash = line.find('-');
+		if (dash != string::npos && dash < line.find(' ')) {
+			unsigned long long start = 0;
+			unsigned long long end = 0;
+			istringstream(line.substr(0, dash)) >> hex >> start;
+			istringstream(line.substr(dash + 1)) >> hex >> end;
+			inMapping = (unsigned long long)address >= start && (unsigned long long)address < end;
+		}
+		else if (inMapping && line.compare(0, 14, "AnonHugePages:") == 0) {
+			unsigned long long kilobytes = 0;
+			istringstream(line.substr(14)) >> kilobytes;
+			return kilobytes > 0;
+		}
+	}
+	return false;
+}
+
+// enables the "lock pages in memory" privilege in this process's token, which windows needs before it hands out large pages
+// returns false if the account was never granted the privilege, since a process can only enable privileges its token already holds
+bool TranspositionTable::enableLockMemoryPrivilege() {
+#if defined(_WIN32)
+	HANDLE token;
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+		return false;
+	}
+	TOKEN_PRIVILEGES privileges;
+	privileges.PrivilegeCount = 1;
+	privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+	// AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED when the token does not hold the privilege, so the last error is checked as well
+	bool enabled =
+		LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+		AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+		GetLastError() == ERROR_SUCCESS;
+	CloseHandle(token);
+	return enabled;
+#else
+	return false;
+#endif
+}
+
+// returns the bucket a key belongs to
+TranspositionTable::Bucket* TranspositionTable::bucketOf(unsigned long long key) {
+	return &buckets[key & (bucketCount - 1)];
+}
+
+#pragma endregion
\ No newline at end of file
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include "Move.h"
+
+using namespace std;
+
+enum Bound : unsigned char {
+	BOUND_NONE,
+	BOUND_UPPER,	// the score is at most the stored score
+	BOUND_LOWER,	// the score is at least the stored score
+	BOUND_EXACT
+};
+
+// kind of memory pages backing the table
+enum PageMode : unsigned char {
+	NORMAL_PAGES,
+	TRANSPARENT_HUGE_PAGES,	// linux backed at least part of the table with transparent 2 MB pages
+	LARGE_PAGES				// the table was allocated directly in 2 MB pages
+};
+
+// what the table remembers about a searched position
+struct TTData {
+	Move move;				// best move found | Move::none() if unknown
+	short int score;		// score from the side to move's point of view, with mates relative to this position
+	unsigned char depth;	// depth the position was searched to
+	Bound bound;			// how score relates to the real score
+};
+
+// a cache of search results keyed by zobrist key, shared by every search thread
+// entries sit in buckets the size of a cache line, so a probe touches a single line of memory
+class TranspositionTable {
+public:
+
+#pragma region constructors
+
+	// allocates a table using about the given number of megabytes
+	TranspositionTable(unsigned int megabytes);
+
+	// frees the table
+	~TranspositionTable();
+
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+#pragma endregion
+
+#pragma region general functions
+
+	// reallocates the table with about the given number of megabytes | the old entries are lost
+	void resize(unsigned int megabytes);
+
+	// empties the table
+	void clear();
+
+	// ages the entries of earlier searches so that they are replaced first
+	void newSearch();
+
+	// returns true and sets data if the position is in the table
+	bool probe(
+		unsigned long long key,
+		TTData* data
+	);
+
+	// stores the result of searching a position
+	void store(
+		unsigned long long key,
+		Move move,
+		int score,
+		int depth,
+		Bound bound
+	);
+
+	// returns the size of the table in megabytes
+	unsigned int megabytes();
+
+	// returns the permille of sampled entries written during the current search
+	unsigned int hashfull();
+
+	// returns a description of the kind of pages the table was allocated in, for logging
+	string pageModeName();
+
+#pragma endregion
+
+private:
+
+	// one entry is two words | check is the key xored with data, so an entry torn by two threads writing at once does not match any key
+	// data holds the move in bits 0-15, score in 16-31, depth in 32-39, bound in 40-41 and generation in 42-47
+	struct Entry {
+		atomic<unsigned long long> check;
+		atomic<unsigned long long> data;
+	};
+
+	static const unsigned char BUCKET_SIZE = 4;
+
+	struct alignas(64) Bucket {
+		Entry entries[BUCKET_SIZE];
+	};
+
+#pragma region variables
+
+	Bucket* buckets = nullptr;		// the table, aligned to a cache line
+	void* memory = nullptr;			// the allocation holding the table
+	size_t allocatedBytes = 0;		// size of the allocation holding the table
+	PageMode mode = NORMAL_PAGES;	// kind of pages the table was allocated in
+	unsigned long long bucketCount = 0;
+	unsigned char generation = 0;	// search counter stored in each entry, wrapping at 64
+
+#pragma endregion
+
+#pragma region helper functions
+
+	// allocates room for the given number of buckets
+	// large pages are tried first, since random probes into a big table miss the TLB on most normal pages
+	void allocate(unsigned long long count);
+
+	// frees the table
+	void release();
+
+	// returns the bucket a key belongs to
+	Bucket* bucketOf(unsigned long long key);
+
+	// returns true if linux has backed any of the memory mapping holding the address with transparent huge pages
+	static bool backedByHugePages(const void* address);
+
+	// enables the "lock pages in memory" privilege in this process's token, which windows needs before it hands out large pages
+	// returns false if the account was never granted the privilege, since a process can only enable privileges its token already holds
+	static bool enableLockMemoryPrivilege();
+
+#pragma endregion
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "Zobrist.h"
+
+using namespace std;
+
+namespace Zobrist {
+
+#pragma region tables
+
+	unsigned long long pieces[2][6][64];
+	unsigned long long castle[16];
+	unsigned long long ep[8];
+	unsigned long long blackMove;
+
+#pragma endregion
+
+	// fills the tables | called once by Position::initTables
+	void init() {
+		Bitboard state = 0x9E3779B97F4A7C15ULL;
+		for (unsigned char color = 0; color < 2; color++) {
+			for (unsigned char type = 0; type < 6; type++) {
+				for (unsigned char square = 0; square < 64; square++) {
+					pieces[color][type][square] = Bitboards::random(&state);
+				}
+			}
+		}
+
+		// no castle rights is 0 so that positions without castling do not need to include it
+		castle[0] = 0;
+		for (unsigned char rights = 1; rights < 16; rights++) {
+			castle[rights] = Bitboards::random(&state);
+		}
+		for (unsigned char col = 0; col < 8; col++) {
+			ep[col] = Bitboards::random(&state);
+		}
+		blackMove = Bitboards::random(&state);
+	}
+}
\ No newline at end of file
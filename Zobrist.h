@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Bitboard.h"
+
+using namespace std;
+
+// random numbers that are xored together to give each position a 64 bit key
+namespace Zobrist {
+
+#pragma region tables
+
+	// one number for each piece type of each color on each square
+	extern unsigned long long pieces[2][6][64];
+
+	// one number for each combination of castle rights
+	extern unsigned long long castle[16];
+
+	// one number for each en passant col
+	extern unsigned long long ep[8];
+
+	// included in the key when it is black's turn
+	extern unsigned long long blackMove;
+
+#pragma endregion
+
+	// fills the tables | called once by Position::initTables
+	void init();
+}
\ No newline at end of file